@@ -0,0 +1,86 @@
+#include "AllocationCounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+static std::atomic<uint64_t> allocationTotal{ 0 };
+static std::atomic<uint64_t> byteTotal{ 0 };
+
+static void* countedAllocate(std::size_t size) {
+    allocationTotal.fetch_add(1, std::memory_order_relaxed);
+    byteTotal.fetch_add(size, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) return memory;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size) {
+    return countedAllocate(size);
+}
+
+void* operator new[](std::size_t size) {
+    return countedAllocate(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return countedAllocate(size);
+    }
+    catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return countedAllocate(size);
+    }
+    catch (...) {
+        return nullptr;
+    }
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+AllocationCount currentAllocations() {
+    AllocationCount count;
+    count.allocations = allocationTotal.load(std::memory_order_relaxed);
+    count.bytes = byteTotal.load(std::memory_order_relaxed);
+    return count;
+}
+
+uint64_t peakRssKb() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+    return counters.PeakWorkingSetSize / 1024;
+#else
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+    return static_cast<uint64_t>(usage.ru_maxrss) / 1024; // bytes there
+#else
+    return static_cast<uint64_t>(usage.ru_maxrss);
+#endif
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdint>
+
+// Totals kept by the benchmark's replacement of the global operator new.
+// Counts every thread, so background workers show up too.
+struct AllocationCount {
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+};
+
+AllocationCount currentAllocations();
+
+// Peak resident set size of the process so far, in KiB (0 if the platform does not say)
+uint64_t peakRssKb();
\ No newline at end of file
@@ -0,0 +1,63 @@
+#include "Benchmark.h"
+#include <iomanip>
+#include <nlohmann/json.hpp>
+
+Benchmark::Benchmark(Format format, std::chrono::milliseconds budget, std::string filter, std::ostream& out)
+    : format(format), budget(budget), filter(std::move(filter)), out(out) {
+}
+
+bool Benchmark::wants(const std::string& name) const {
+    return filter.empty() || name.find(filter) != std::string::npos;
+}
+
+void Benchmark::printHeader() {
+    if (format == Format::Table) {
+        out << std::left << std::setw(34) << "benchmark" << std::right
+            << std::setw(10) << "tasks" << std::setw(12) << "ops" << std::setw(14) << "ns/op"
+            << std::setw(12) << "allocs/op" << std::setw(12) << "bytes/op" << std::setw(14) << "peak RSS KiB" << '\n';
+    }
+    else if (format == Format::Csv) {
+        out << "name,tasks,ops,ns_per_op,allocs_per_op,bytes_per_op,peak_rss_kb\n";
+    }
+}
+
+void Benchmark::record(const std::string& name, size_t tasks, uint64_t ops, std::chrono::steady_clock::duration elapsed,
+    const AllocationCount& before) {
+    AllocationCount after = currentAllocations();
+
+    BenchResult result;
+    result.name = name;
+    result.tasks = tasks;
+    result.ops = ops;
+    result.nsPerOp = std::chrono::duration<double, std::nano>(elapsed).count() / ops;
+    result.allocsPerOp = static_cast<double>(after.allocations - before.allocations) / ops;
+    result.bytesPerOp = static_cast<double>(after.bytes - before.bytes) / ops;
+    result.peakRssKb = peakRssKb();
+    print(result);
+}
+
+void Benchmark::print(const BenchResult& result) {
+    switch (format) {
+    case Format::Table:
+        out << std::left << std::setw(34) << result.name << std::right << std::fixed
+            << std::setw(10) << result.tasks << std::setw(12) << result.ops
+            << std::setw(14) << std::setprecision(1) << result.nsPerOp
+            << std::setw(12) << std::setprecision(2) << result.allocsPerOp
+            << std::setw(12) << std::setprecision(1) << result.bytesPerOp
+            << std::setw(14) << result.peakRssKb << '\n' << std::defaultfloat;
+        break;
+    case Format::Json: {
+        nlohmann::json line = {
+            { "name", result.name }, { "tasks", result.tasks }, { "ops", result.ops },
+            { "ns_per_op", result.nsPerOp }, { "allocs_per_op", result.allocsPerOp },
+            { "bytes_per_op", result.bytesPerOp }, { "peak_rss_kb", result.peakRssKb } };
+        out << line.dump() << '\n';
+        break;
+    }
+    case Format::Csv:
+        out << result.name << ',' << result.tasks << ',' << result.ops << ',' << result.nsPerOp << ','
+            << result.allocsPerOp << ',' << result.bytesPerOp << ',' << result.peakRssKb << '\n';
+        break;
+    }
+    out.flush();
+}
\ No newline at end of file
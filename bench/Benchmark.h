@@ -0,0 +1,69 @@
+#pragma once
+
+#include "AllocationCounter.h"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+struct BenchResult {
+    std::string name;
+    size_t tasks = 0;     // size of the task list the benchmark ran against
+    uint64_t ops = 0;
+    double nsPerOp = 0.0;
+    double allocsPerOp = 0.0;
+    double bytesPerOp = 0.0;
+    uint64_t peakRssKb = 0;
+};
+
+// Times operations and prints one result per benchmark as soon as it finishes
+class Benchmark {
+public:
+    enum class Format { Table, Json, Csv };
+
+    Benchmark(Format format, std::chrono::milliseconds budget, std::string filter, std::ostream& out = std::cout);
+
+    bool wants(const std::string& name) const;
+
+    // Calls op(i) for i = 0, 1, ... until maxOps calls or the time budget is used up
+    template <typename Op>
+    void measure(const std::string& name, size_t tasks, uint64_t maxOps, Op&& op) {
+        if (!wants(name)) return;
+        using Clock = std::chrono::steady_clock;
+        AllocationCount before = currentAllocations();
+        auto started = Clock::now();
+        auto deadline = started + budget;
+
+        uint64_t ops = 0;
+        while (ops < maxOps) {
+            op(ops);
+            ++ops;
+            // Reading the clock costs about as much as the cheapest operations, so look less often later
+            if ((ops < 64 || ops % 64 == 0) && Clock::now() >= deadline) break;
+        }
+        record(name, tasks, ops, Clock::now() - started, before);
+    }
+
+    // Runs a bulk operation once and reports it per item (e.g. per task saved)
+    template <typename Op>
+    void measureOnce(const std::string& name, size_t tasks, uint64_t items, Op&& op) {
+        if (!wants(name)) return;
+        using Clock = std::chrono::steady_clock;
+        AllocationCount before = currentAllocations();
+        auto started = Clock::now();
+        op();
+        record(name, tasks, items == 0 ? 1 : items, Clock::now() - started, before);
+    }
+
+    void printHeader();
+
+private:
+    void record(const std::string& name, size_t tasks, uint64_t ops, std::chrono::steady_clock::duration elapsed,
+        const AllocationCount& before);
+    void print(const BenchResult& result);
+
+    Format format;
+    std::chrono::milliseconds budget;
+    std::string filter;
+    std::ostream& out;
+};
\ No newline at end of file
@@ -0,0 +1,341 @@
+#include "Benchmark.h"
+#include "TaskManager.h"
+#include "QueryExecutor.h"
+#include "JsonStorage.h"
+#include "BinaryStorage.h"
+#include "LoggerService.h"
+#include "Scheduler.h"
+#include "DeadlineKernels.h"
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// Results are added here so the optimizer cannot drop the work that produced them
+static volatile size_t sink = 0;
+
+static const char* const usage =
+    "Usage: task_manager_bench [--sizes 1k,100k,1m] [--format table|json|csv] [--budget-ms 1000]\n"
+    "                          [--filter <name part>] [--seed <n>]\n\n"
+    "Runs every benchmark against task lists of each size. Bulk benchmarks (core.add, storage.*,\n"
+    "services.logger) report per task or per event; the others per call, repeated until the budget\n"
+    "is spent. --format json prints one object per result line. 10m is supported but needs several GB,\n"
+    "except for --filter kernels., which only builds the deadline and completion columns.\n";
+
+// Deterministic synthetic tasks: a few words per field, 50 tags, deadlines within a month of now
+static std::vector<Task> makeTasks(size_t count, uint64_t seed) {
+    static const char* const words[] = { "alpha", "report", "review", "deploy", "invoice", "meeting", "draft", "budget",
+        "client", "update", "backup", "release", "design", "call", "plan", "fix" };
+    std::mt19937_64 random(seed);
+    auto word = [&random]() { return words[random() % 16]; };
+    const auto now = std::chrono::time_point_cast<std::chrono::seconds>(std::chrono::system_clock::now());
+
+    std::vector<Task> tasks;
+    tasks.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        std::string title = std::string(word()) + ' ' + word() + " #" + std::to_string(i);
+        std::string description = std::string(word()) + ' ' + word() + ' ' + word() + ' ' + word();
+        auto deadline = now + std::chrono::minutes(static_cast<int64_t>(random() % (60 * 24 * 60)) - 60 * 24 * 30);
+        tasks.emplace_back(std::move(title), std::move(description), deadline,
+            static_cast<Priority>(random() % 3), "tag" + std::to_string(random() % 50), random() % 4 == 0);
+    }
+    return tasks;
+}
+
+static size_t parseSize(const std::string& text) {
+    size_t consumed = 0;
+    size_t value = std::stoul(text, &consumed);
+    std::string suffix = text.substr(consumed);
+    if (suffix == "k" || suffix == "K") return value * 1000;
+    if (suffix == "m" || suffix == "M") return value * 1000 * 1000;
+    if (!suffix.empty()) throw std::runtime_error("Bad size: " + text);
+    return value;
+}
+
+static std::vector<size_t> parseSizes(const std::string& text) {
+    std::vector<size_t> sizes;
+    size_t start = 0;
+    while (start <= text.size()) {
+        size_t comma = text.find(',', start);
+        if (comma == std::string::npos) comma = text.size();
+        sizes.push_back(parseSize(text.substr(start, comma - start)));
+        start = comma + 1;
+    }
+    return sizes;
+}
+
+// Building the task list is the expensive part, so it is skipped when none of its benchmarks is selected
+static bool wantsAnyOf(const Benchmark& bench, std::initializer_list<const char*> names) {
+    for (const char* name : names) {
+        if (bench.wants(name)) return true;
+    }
+    return false;
+}
+
+static void runCore(Benchmark& bench, size_t count, uint64_t seed, const fs::path& workDir) {
+    if (!wantsAnyOf(bench, { "core.add", "core.edit", "core.set_completed", "core.snapshot_after_change",
+        "query.sort_by_deadline", "query.sort_by_priority", "query.next_10", "query.search_keyword", "query.filter_tag",
+        "query.composite", "counters.upcoming", "counters.overdue", "storage.json_save", "storage.json_load",
+        "storage.save_snap", "storage.load_snap", "core.remove" })) {
+        return;
+    }
+    TaskManager manager;
+    std::vector<Task> replacements;
+    {
+        std::vector<Task> dataset = makeTasks(count, seed);
+        replacements = makeTasks(1024, seed + 1);
+        auto populate = [&]() {
+            for (const auto& task : dataset) manager.addTask(task);
+        };
+        if (bench.wants("core.add")) bench.measureOnce("core.add", count, count, populate);
+        else populate();
+    }
+
+    // Mutations address tasks by id, like the CLI does
+    std::mt19937_64 random(seed + 2);
+    std::vector<TaskId> picks(4096);
+    for (auto& pick : picks) pick = manager.getTaskByIndex(random() % count).getId();
+    auto pick = [&picks](uint64_t i) { return picks[i % picks.size()]; };
+
+    bench.measure("core.edit", count, count, [&](uint64_t i) {
+        manager.editTask(pick(i), replacements[i % replacements.size()]);
+    });
+    bench.measure("core.set_completed", count, count, [&](uint64_t i) {
+        manager.setCompleted(pick(i), i % 2 == 0);
+    });
+    bench.measure("core.snapshot_after_change", count, count, [&](uint64_t i) {
+        manager.setCompleted(pick(i), i % 2 == 0);
+        sink += manager.snapshot()->tasks.size();
+    });
+
+    bench.measure("query.sort_by_deadline", count, count, [&](uint64_t) {
+        sink += manager.getTasksSortedByDeadline().size();
+    });
+    bench.measure("query.sort_by_priority", count, count, [&](uint64_t) {
+        sink += manager.getTasksSortedByPriority().size();
+    });
+    bench.measure("query.next_10", count, count, [&](uint64_t) {
+        sink += manager.getNextTasks(10).size();
+    });
+    const std::string keywords[] = { "report", "budget #1", "deploy", "missing" };
+    bench.measure("query.search_keyword", count, count, [&](uint64_t i) {
+        sink += manager.findTasksByKeyword(keywords[i % 4]).size();
+    });
+    std::vector<std::string> tags;
+    for (int i = 0; i < 50; ++i) tags.push_back("tag" + std::to_string(i));
+    bench.measure("query.filter_tag", count, count, [&](uint64_t i) {
+        sink += manager.filterTasksByTag(tags[i % tags.size()]).size();
+    });
+    TaskQuery query = TaskQuery::parse("tag=tag7 and not completed and due within 7d order by deadline limit 20");
+    bench.measure("query.composite", count, count, [&](uint64_t) {
+        sink += QueryExecutor::run(manager, query).rows.size();
+    });
+
+    bench.measure("counters.upcoming", count, count, [&](uint64_t) {
+        sink += manager.countUpcomingDeadlines();
+    });
+    bench.measure("counters.overdue", count, count, [&](uint64_t) {
+        sink += manager.countOverduedDeadlines();
+    });
+
+    const std::string path = (workDir / ("tasks-" + std::to_string(count) + ".json")).string();
+    JsonStorage storage;
+    bench.measureOnce("storage.json_save", count, count, [&]() {
+        storage.saveToFile(path, manager.getAllTasks());
+    });
+    TaskTable loaded;
+    bench.measureOnce("storage.json_load", count, count, [&]() {
+        loaded = storage.loadFromFile(path);
+    });
+    sink += loaded.size();
+    loaded = TaskTable();
+
+    // Opening a snapshot the way the app does: mapping, copying the rows and rebuilding every index
+    const std::string snapPath = (workDir / ("tasks-" + std::to_string(count) + ".snap")).string();
+    if (wantsAnyOf(bench, { "storage.save_snap", "storage.load_snap" })) {
+        BinaryStorage snapStorage;
+        auto saveSnap = [&]() { snapStorage.saveToFile(snapPath, manager.getAllTasks()); };
+        if (bench.wants("storage.save_snap")) bench.measureOnce("storage.save_snap", count, count, saveSnap);
+        else saveSnap();
+    }
+    if (bench.wants("storage.load_snap")) {
+        TaskManager reopened;
+        bench.measureOnce("storage.load_snap", count, count, [&]() {
+            reopened.loadTasks(snapPath);
+        });
+        sink += reopened.getTaskCount();
+    }
+
+    // Last, since it shrinks the list; a random task each time, as picked ids run out
+    bench.measure("core.remove", count, count, [&](uint64_t) {
+        manager.removeTask(manager.getTaskByIndex(random() % manager.getTaskCount()).getId());
+    });
+}
+
+// What the kernels replace: a branchy per-task loop
+static size_t referenceCount(const std::vector<int64_t>& deadlines, const std::vector<uint64_t>& completed,
+    size_t count, int64_t from, int64_t to, std::vector<uint64_t>* selected) {
+    size_t total = 0;
+    for (size_t i = 0; i < count; ++i) {
+        bool done = (completed[i / 64] >> (i % 64)) & 1;
+        if (!done && deadlines[i] >= from && deadlines[i] <= to) {
+            ++total;
+            if (selected) (*selected)[i / 64] |= uint64_t(1) << (i % 64);
+        }
+    }
+    return total;
+}
+
+// Every supported kernel level must agree with the reference loop on every prefix length
+// (so each tail size is covered), on empty and unbounded windows and on deadlines at the
+// extremes of int64
+static void verifyKernels(const std::vector<int64_t>& deadlines, const std::vector<uint64_t>& completed, int64_t now) {
+    using DeadlineKernels::Level;
+    const int64_t hour = TaskTable::toTicks(std::chrono::system_clock::time_point(std::chrono::hours(1)));
+    const std::pair<int64_t, int64_t> windows[] = {
+        { now, now + 48 * hour }, { INT64_MIN, now - 1 }, { now + 1, INT64_MAX }, { INT64_MIN, INT64_MAX },
+        { now, now }, { now, now - 1 }, { deadlines[0], deadlines[0] }, { -1, 1 } };
+    const size_t fullCount = deadlines.size();
+    std::vector<size_t> counts;
+    for (size_t n = 0; n <= std::min<size_t>(fullCount, 200); ++n) counts.push_back(n);
+    counts.push_back(fullCount);
+
+    for (Level level : { Level::Scalar, Level::Sse2, Level::Avx2 }) {
+        if (!DeadlineKernels::isSupported(level)) continue;
+        for (const auto& window : windows) {
+            for (size_t n : counts) {
+                std::vector<uint64_t> expectedBits((n + 63) / 64), bits((n + 63) / 64, ~uint64_t(0));
+                size_t expected = referenceCount(deadlines, completed, n, window.first, window.second, &expectedBits);
+                size_t counted = DeadlineKernels::countIncompleteDue(level, deadlines.data(), completed.data(), n,
+                    window.first, window.second);
+                size_t selected = DeadlineKernels::selectIncompleteDue(level, deadlines.data(), completed.data(), n,
+                    window.first, window.second, bits.data());
+                if (counted != expected || selected != expected || bits != expectedBits) {
+                    throw std::runtime_error(std::string("Deadline kernel ") + DeadlineKernels::levelName(level) +
+                        " disagrees with the reference loop at " + std::to_string(n) + " tasks");
+                }
+            }
+        }
+    }
+}
+
+// The deadline kernels on their own, over columns shaped like the task list's
+static void runKernels(Benchmark& bench, size_t count, uint64_t seed) {
+    using DeadlineKernels::Level;
+    if (!wantsAnyOf(bench, { "kernels.count_due.", "kernels.select_due." })) return;
+
+    const int64_t now = TaskTable::toTicks(std::chrono::system_clock::now());
+    const int64_t hour = TaskTable::toTicks(std::chrono::system_clock::time_point(std::chrono::hours(1)));
+    std::mt19937_64 random(seed + 3);
+    std::vector<int64_t> deadlines(count);
+    std::vector<uint64_t> completed((count + 63) / 64);
+    for (size_t i = 0; i < count; ++i) {
+        deadlines[i] = now + static_cast<int64_t>(random() % (60 * 24)) * hour - 30 * 24 * hour; // within a month of now
+        if (random() % 4 == 0) completed[i / 64] |= uint64_t(1) << (i % 64);
+    }
+    // Rows past the end may not be marked completed, as in TaskTable
+    if (count % 64 != 0) completed.back() &= (uint64_t(1) << (count % 64)) - 1;
+    // A few deadlines at the int64 extremes, which a signed/unsigned mix-up would miscount
+    deadlines[0] = INT64_MIN;
+    if (count > 1) deadlines[1] = INT64_MAX;
+    if (count > 2) deadlines[2] = now;
+
+    verifyKernels(deadlines, completed, now);
+
+    bench.measure("kernels.count_due.branchy", count, count, [&](uint64_t) {
+        sink += referenceCount(deadlines, completed, count, now, now + 48 * hour, nullptr);
+    });
+    std::vector<uint64_t> selected(completed.size());
+    for (Level level : { Level::Scalar, Level::Sse2, Level::Avx2 }) {
+        if (!DeadlineKernels::isSupported(level)) continue;
+        std::string suffix = DeadlineKernels::levelName(level);
+        bench.measure("kernels.count_due." + suffix, count, count, [&](uint64_t) {
+            sink += DeadlineKernels::countIncompleteDue(level, deadlines.data(), completed.data(), count, now, now + 48 * hour);
+        });
+        bench.measure("kernels.select_due." + suffix, count, count, [&](uint64_t) {
+            sink += DeadlineKernels::selectIncompleteDue(level, deadlines.data(), completed.data(), count,
+                INT64_MIN, now - 1, selected.data());
+        });
+    }
+}
+
+// Events per second from logEvent until stop() has written the last one
+static void runLogger(Benchmark& bench, size_t count, const fs::path& workDir) {
+    if (!bench.wants("services.logger")) return;
+    auto scheduler = std::make_shared<Scheduler>();
+    scheduler->start();
+    LoggerService logger((workDir / ("logs-" + std::to_string(count))).string(), scheduler);
+    logger.start();
+
+    const std::string message = "User entered command: list";
+    bench.measureOnce("services.logger", count, count, [&]() {
+        for (size_t i = 0; i < count; ++i) logger.logEvent(message);
+        logger.stop();
+    });
+    scheduler->stop();
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<size_t> sizes = { 1000, 100000, 1000000 };
+    Benchmark::Format format = Benchmark::Format::Table;
+    std::chrono::milliseconds budget(1000);
+    std::string filter;
+    uint64_t seed = 42;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            auto value = [&]() -> std::string {
+                if (i + 1 >= argc) throw std::runtime_error(arg + " needs a value");
+                return argv[++i];
+            };
+
+            if (arg == "--sizes") sizes = parseSizes(value());
+            else if (arg == "--budget-ms") budget = std::chrono::milliseconds(std::stol(value()));
+            else if (arg == "--filter") filter = value();
+            else if (arg == "--seed") seed = std::stoull(value());
+            else if (arg == "--format") {
+                std::string name = value();
+                if (name == "table") format = Benchmark::Format::Table;
+                else if (name == "json") format = Benchmark::Format::Json;
+                else if (name == "csv") format = Benchmark::Format::Csv;
+                else throw std::runtime_error("Unknown format: " + name);
+            }
+            else if (arg == "--help" || arg == "-h") {
+                std::cout << usage;
+                return 0;
+            }
+            else throw std::runtime_error("Unknown option: " + arg);
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << "\n\n" << usage;
+        return 1;
+    }
+
+    fs::path workDir = fs::temp_directory_path() / ("task_manager_bench-" + std::to_string(std::random_device()()));
+    fs::create_directories(workDir);
+
+    Benchmark bench(format, budget, filter);
+    bench.printHeader();
+    try {
+        for (size_t count : sizes) {
+            if (count == 0) continue;
+            runCore(bench, count, seed, workDir);
+            runKernels(bench, count, seed);
+            runLogger(bench, count, workDir);
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Benchmark failed: " << e.what() << '\n';
+        fs::remove_all(workDir);
+        return 1;
+    }
+
+    fs::remove_all(workDir);
+    return 0;
+}
\ No newline at end of file
@@ -1,8 +1,15 @@
 ﻿#include "App.h"
+#include "BatchRunner.h"
 #include "CommandParser.h"
 #include "DateTimeUtils.h"
+#include "JsonStorage.h"
+#include "QueryExecutor.h"
+#include "TaskRenderer.h"
 #include <iostream>
 #include <chrono>
+#include <iomanip>
+#include <filesystem>
+#include <fstream>
 #include <ConsoleMutex.h>
 
 
@@ -10,18 +17,22 @@ void App::run() {
     std::cout << "📌 Task Manager CLI started!\nType 'help' to see available commands.\n\n";
 
     manager->loadTasks(filename);// Load tasks from persistent storage
+    reportLoadStats();
 
-    // Initialize background services (logger, reminders, suggestions, autosaves)
-    loggerService = std::make_unique<LoggerService>("log.json");
+    // Initialize background services (logger, reminders, suggestions, autosaves).
+    // They share the scheduler's worker threads instead of running one thread each.
+    scheduler->start();
+
+    loggerService = std::make_unique<LoggerService>(logDirectory, scheduler);
     loggerService->start();
 
-    reminderService = std::make_unique<ReminderService>(manager);
+    reminderService = std::make_unique<ReminderService>(manager, scheduler);
     reminderService->start();
 
-    hintService = std::make_unique<HintService>(manager);
+    hintService = std::make_unique<HintService>(manager, scheduler);
     hintService->start();
 
-    autoSaveService = std::make_unique<AutoSaveService>(manager);
+    autoSaveService = std::make_unique<AutoSaveService>(manager, scheduler);
     autoSaveService->start();
 
 
@@ -42,15 +53,23 @@ void App::run() {
                 << "  sort       Sort tasks by 'deadline' or 'priority'\n"
                 << "  filter     Filter tasks by 'tag' or 'today'\n"
                 << "  search     Search tasks by keyword\n"
+                << "  query      Combine conditions, e.g. tag=work and due within 7d and not completed order by deadline limit 10\n"
                 << "  overdue    Show overdue tasks\n"
                 << "  completed  Show completed tasks\n"
                 << "  upcoming   Show tasks due in next 48h\n"
+                << "  next       Show the 10 pending tasks to do first (by priority, then deadline)\n"
+                << "  view       Choose the listing layout (verbose or table) and page size\n"
                 << "  add        Add a new task\n"
-                << "  delete     Remove task by index\n"
-                << "  edit       Edit task by index\n"
+                << "  delete     Remove task by ID\n"
+                << "  edit       Edit task by ID\n"
                 << "  save       Save tasks to file\n"
                 << "  load       Load tasks from file\n"
+                << "  import     Append tasks from a CSV or NDJSON file\n"
+                << "  export     Write all tasks to a CSV or NDJSON file\n"
+                << "  convert    Convert between JSON (text or epoch deadlines) and binary snapshot (.snap) files\n"
                 << "  reminder   Toggle reminders on/off\n"
+                << "  stats      Show background job timings\n"
+                << "  logs       Show log records from a time range\n"
                 << "  exit       Save and quit\n\n";
         }
         else if (command == "list") {
@@ -74,22 +93,26 @@ void App::run() {
                 continue;
             }
 
-            std::vector<Task> sorted;
             // Determine sorting strategy based on user input
             if (type == "1") {
-                sorted = manager->getTasksSortedByDeadline();
+                // Deadline order is maintained by the manager, so walk it directly
+                TaskRenderer renderer = makeRenderer();
+                for (const auto& entry : manager->getDeadlineIndex()) {
+                    if (!renderer.add(manager->getTaskByIndex(entry.second))) break;
+                }
                 loggerService->logEvent("User entered command: " + command + " by Deadline");
             }
             else if (type == "2") {
-                sorted = manager->getTasksSortedByPriority();
+                TaskRenderer renderer = makeRenderer();
+                for (const auto& entry : manager->getTasksSortedByPriority()) {
+                    if (!renderer.add(entry.task)) break;
+                }
                 loggerService->logEvent("User entered command: " + command + " by Priority");
             }
             else {
                 std::cout << "Invalid sort type.\n";
                 continue;
             }
-
-            for (const auto& task : sorted) task.print();
         }
         else if (command == "filter") {
             std::lock_guard<std::mutex> lock(consoleMutex);
@@ -122,7 +145,7 @@ void App::run() {
 
                 auto filtered = manager->filterTasksByTag(tag);
                 if (filtered.empty()) std::cout << "No tasks found with tag '" << tag << "'.\n";
-                else for (const auto& task : filtered) task.print();
+                else renderTasks(filtered);
                 loggerService->logEvent("User entered command: " + command + " by Tag: " + tag);
             }
             else if (type == "2") {
@@ -148,9 +171,37 @@ void App::run() {
             // Search tasks by keyword match in title or description
             auto results = manager->findTasksByKeyword(keyword);
             if (results.empty()) std::cout << "No matching tasks found.\n";
-            else for (const auto& task : results) task.print();
+            else renderTasks(results);
             loggerService->logEvent("User entered command: " + command + ": " + keyword);
         }
+        else if (command == "query") {
+            std::lock_guard<std::mutex> lock(consoleMutex);
+            std::string text;
+            std::cout << "Enter query (or 'cancel' to abort): ";
+            std::getline(std::cin, text);
+            ActivityTracker::updateActivityTime();
+
+            if (text == "cancel") {
+                std::cout << "Query cancelled.\n";
+                loggerService->logEvent("User cancelled query");
+                continue;
+            }
+
+            try {
+                QueryResult result = QueryExecutor::run(*manager, TaskQuery::parse(text));
+                TaskRenderer renderer = makeRenderer();
+                for (const auto& entry : result.rows) {
+                    if (!renderer.add(entry.task)) break;
+                }
+                renderer.flush();
+                std::cout << result.rows.size() << " task(s), plan: " << result.plan << "\n";
+                loggerService->logEvent("User entered command: " + command + ": " + text);
+            }
+            catch (const std::exception& e) {
+                std::cout << "⚠️ " << e.what() << "\n";
+                loggerService->logEvent(std::string("Query failed: ") + e.what());
+            }
+        }
         else if (command == "overdue") {
             std::lock_guard<std::mutex> lock(consoleMutex);
             showOverdueTasks();
@@ -166,14 +217,22 @@ void App::run() {
             showUpcomingDeadlines();
             loggerService->logEvent("User entered command: " + command);
         }
+        else if (command == "next") {
+            std::lock_guard<std::mutex> lock(consoleMutex);
+            TaskRenderer renderer = makeRenderer();
+            for (const auto& entry : manager->getNextTasks(10)) {
+                if (!renderer.add(entry.task)) break;
+            }
+            loggerService->logEvent("User entered command: " + command);
+        }
 
         else if (command == "add") {
             std::lock_guard<std::mutex> lock(consoleMutex);
             try {
                 // Create new task using UI prompts
                 Task task = ui.promptForTask();
-                manager->addTask(task);
-                std::cout << "✅ Task added.\n";
+                TaskId id = manager->addTask(task);
+                std::cout << "✅ Task added with ID " << id << ".\n";
                 loggerService->logEvent("User added new task: " + task.getTitle());
             }
             catch (const std::exception& e) {
@@ -183,12 +242,12 @@ void App::run() {
         }
         else if (command == "delete") {
             std::lock_guard<std::mutex> lock(consoleMutex);
-            size_t index;
+            TaskId id;
             std::string input;
             bool taskDeleted = false;
-            // Delete task by index, with input validation and cancellation support
+            // Delete task by ID, with input validation and cancellation support
             while (!taskDeleted) {
-                std::cout << "Enter the index of the task to delete (or 'cancel' to abort): ";
+                std::cout << "Enter the ID of the task to delete (or 'cancel' to abort): ";
                 std::getline(std::cin, input);
                 ActivityTracker::updateActivityTime();
 
@@ -198,36 +257,36 @@ void App::run() {
                 }
 
                 try {
-                    index = std::stoul(input); 
+                    id = std::stoull(input); 
                 }
                 catch (...) {
-                    std::cout << "Invalid input! Please enter a valid index.\n";
+                    std::cout << "Invalid input! Please enter a valid ID.\n";
                     continue; 
                 }
 
                 std::string title;
                 try {
-                    title = manager->getTaskByIndex(index).getTitle();
+                    title = manager->getTask(id).getTitle();
                 }
                 catch (const std::exception& e) {
-                    std::cout << "Invalid index! Task not found.\n";
+                    std::cout << "Invalid ID! Task not found.\n";
                     continue; 
                 }
 
-                if (manager->removeTask(index)) {
+                if (manager->removeTask(id)) {
                     std::cout << "Task deleted successfully.\n";
                     loggerService->logEvent("User deleted task: " + title);
                     taskDeleted = true;
                 }
                 else {
-                    std::cout << "Invalid index! Task not found.\n";
+                    std::cout << "Invalid ID! Task not found.\n";
                 }
             }
             }
         else if (command == "edit") {
             std::lock_guard<std::mutex> lock(consoleMutex);
             try {
-                // Launch task edit prompt; exceptions may arise from invalid index or input
+                // Launch task edit prompt; exceptions may arise from invalid ID or input
                 editTask();
                 loggerService->logEvent("User edited task.");
             }
@@ -238,7 +297,7 @@ void App::run() {
             }
         else if (command == "save") {
             std::lock_guard<std::mutex> lock(consoleMutex);
-            manager->saveTasks(filename); // Manually save tasks to file
+            manager->commitChanges(); // Commit journaled changes (compacting into tasks.json when due)
             std::cout << "💾 Tasks saved.\n";
             loggerService->logEvent("User entered command: " + command);
         }
@@ -246,8 +305,32 @@ void App::run() {
             std::lock_guard<std::mutex> lock(consoleMutex);
             manager->loadTasks(filename); // Reload tasks from file (overwrites memory)
             std::cout << "📂 Tasks loaded.\n";
+            reportLoadStats();
             loggerService->logEvent("User entered command: " + command);
         }
+        else if (command == "import" || command == "export") {
+            std::lock_guard<std::mutex> lock(consoleMutex);
+            try {
+                if (command == "import") importTasks();
+                else exportTasks();
+                loggerService->logEvent("User entered command: " + command);
+            }
+            catch (const std::exception& e) {
+                std::cout << "⚠️ " << e.what() << "\n";
+                loggerService->logEvent(std::string("Bulk ") + command + " failed: " + e.what());
+            }
+        }
+        else if (command == "convert") {
+            std::lock_guard<std::mutex> lock(consoleMutex);
+            try {
+                convertStorage();
+                loggerService->logEvent("User entered command: " + command);
+            }
+            catch (const std::exception& e) {
+                std::cout << "⚠️ " << e.what() << "\n";
+                loggerService->logEvent(std::string("Convert aborted: ") + e.what());
+            }
+        }
         else if (command == "reminder") {
             std::lock_guard<std::mutex> lock(consoleMutex);
             // Toggle background reminder service on or off
@@ -262,15 +345,38 @@ void App::run() {
                 loggerService->logEvent("User enabled reminder");
             }
         }
+        else if (command == "view") {
+            std::lock_guard<std::mutex> lock(consoleMutex);
+            try {
+                chooseView();
+                loggerService->logEvent("User entered command: " + command);
+            }
+            catch (const std::exception& e) {
+                std::cout << "⚠️ " << e.what() << "\n";
+            }
+        }
+        else if (command == "stats") {
+            std::lock_guard<std::mutex> lock(consoleMutex);
+            printSchedulerStats();
+            loggerService->logEvent("User entered command: " + command);
+        }
+        else if (command == "logs") {
+            std::lock_guard<std::mutex> lock(consoleMutex);
+            try {
+                showLogs();
+                loggerService->logEvent("User entered command: " + command);
+            }
+            catch (const std::exception& e) {
+                std::cout << "⚠️ " << e.what() << "\n";
+                loggerService->logEvent(std::string("Logs aborted: ") + e.what());
+            }
+        }
         else if (command == "exit") {
             std::lock_guard<std::mutex> lock(consoleMutex);
             // Perform cleanup: save data and stop all background services
-            manager->saveTasks(filename);
-            if(reminderService->isRunning()) reminderService->stop();
-            hintService->stop();
-            autoSaveService->stop();
+            manager->commitChanges();
             loggerService->logEvent("User entered command: " + command);
-            loggerService->stop();
+            stopServices();
             std::cout << "👋 Exiting...\n";
             break; // Terminate main loop
         }
@@ -282,6 +388,51 @@ void App::run() {
     }
 }
 
+int App::runBatch(const std::vector<std::string>& args) {
+    if (args[0] == "--help" || args[0] == "-h") {
+        std::cout << BatchRunner::usage();
+        return 0;
+    }
+
+    manager->loadTasks(filename);
+    BatchRunner runner(*manager);
+    int status = 0;
+
+    if (args[0] == "--script") {
+        std::string path = args.size() > 1 ? args[1] : "-";
+        std::ifstream file;
+        if (path != "-") {
+            file.open(path);
+            if (!file.is_open()) {
+                std::cerr << "Cannot open script: " << path << "\n";
+                return 1;
+            }
+        }
+
+        BatchRunner::Summary summary = runner.runScript(path == "-" ? std::cin : file);
+        double seconds = std::chrono::duration<double>(summary.elapsed).count();
+        std::cerr << summary.commands << " command(s), " << summary.failed << " failed, in "
+            << std::fixed << std::setprecision(3) << seconds << " s ("
+            << std::setprecision(0) << (seconds > 0 ? summary.commands / seconds : 0.0) << " commands/s)\n";
+        if (summary.failed > 0) status = 1;
+    }
+    else {
+        CommandParser parser;
+        try {
+            runner.execute(parser.parseArgs(args));
+        }
+        catch (const std::exception& e) {
+            runner.flush();
+            std::cerr << "Error: " << e.what() << "\n";
+            status = 1;
+        }
+        runner.flush();
+    }
+
+    manager->commitChanges(); // one save for the whole batch
+    return status;
+}
+
 void App::showUpcomingDeadlines() {
     std::cout << "\n\u2753 Upcoming Deadlines:\n\n";
 
@@ -290,20 +441,14 @@ void App::showUpcomingDeadlines() {
     auto now = system_clock::now();
     auto soon = now + hours(48);
 
-    bool found = false;
-    size_t index = 0;
     // Display tasks whose deadlines fall within the next 48 hours
-    for (const auto& task : manager->getAllTasks()) {
-        auto deadline = task.getDeadline();
-        if (deadline >= now && deadline <= soon) {
-            std::cout << "[" << index << "] ";
-            task.print();
-            found = true;
-        }
-        index++;
+    TaskRenderer renderer = makeRenderer();
+    for (const auto& entry : manager->getTasksDueBetween(now, soon)) {
+        if (!renderer.add(entry.task)) break;
     }
+    renderer.flush();
 
-    if (!found) std::cout << "No upcoming tasks in the next 48 hours.\n\n";
+    if (renderer.getRendered() == 0) std::cout << "No upcoming tasks in the next 48 hours.\n\n";
 }
 
 void App::showTasksForToday() {
@@ -313,83 +458,67 @@ void App::showTasksForToday() {
     auto todayStart = DateTimeUtils::startOfDay(now);
     auto todayEnd = DateTimeUtils::endOfDay(now);
 
-    bool found = false;
-    size_t index = 0;
     // List all tasks due today regardless of completion status
-    for (const auto& task : manager->getAllTasks()) {
-        auto deadline = task.getDeadline();
-        if (deadline >= todayStart && deadline <= todayEnd) {
-            std::cout << "[" << index << "] ";
-            task.print();
-            found = true;
-        }
-        index++;
+    TaskRenderer renderer = makeRenderer();
+    for (const auto& entry : manager->getTasksDueBetween(todayStart, todayEnd)) {
+        if (!renderer.add(entry.task)) break;
     }
+    renderer.flush();
 
-    if (!found) std::cout << "No tasks scheduled for today.\n\n";
+    if (renderer.getRendered() == 0) std::cout << "No tasks scheduled for today.\n\n";
 }
 
 void App::showOverdueTasks() {
     std::cout << "\n\u26A0 Overdue Tasks (Not Completed):\n\n";
     // Focus only on uncompleted tasks with a past deadline
     auto now = std::chrono::system_clock::now();
-    bool found = false;
-    size_t index = 0;
-    for (const auto& task : manager->getAllTasks()) {
-        if (task.getDeadline() < now && !task.getCompleted()) { 
-            std::cout << "[" << index << "] ";
-            task.print();
-            found = true;
-        }
-        index++;
+    TaskRenderer renderer = makeRenderer();
+    for (const auto& entry : manager->getTasksDueBefore(now)) {
+        if (!entry.task.getCompleted() && !renderer.add(entry.task)) break;
     }
+    renderer.flush();
 
-    if (!found) std::cout << "No overdue tasks.\n\n";
+    if (renderer.getRendered() == 0) std::cout << "No overdue tasks.\n\n";
 }
 
 void App::showCompletedTasks() {
     std::cout << "\n\u2705 Completed Tasks:\n\n";
 
-    bool found = false;
-    size_t index = 0;
     // Display tasks explicitly marked as completed
+    TaskRenderer renderer = makeRenderer();
     for (const auto& task : manager->getAllTasks()) {
-        if (task.getCompleted()) { 
-            std::cout << "[" << index << "] ";
-            task.print();
-            found = true;
-        }
-        index++;
+        if (task.getCompleted() && !renderer.add(task)) break;
     }
+    renderer.flush();
 
-    if (!found) std::cout << "No completed tasks.\n\n";
+    if (renderer.getRendered() == 0) std::cout << "No completed tasks.\n\n";
 }
 
 void App::editTask() {
     std::string input;
-    std::cout << "Enter task index to edit (or 'cancel' to abort): ";
+    std::cout << "Enter task ID to edit (or 'cancel' to abort): ";
     std::getline(std::cin, input);
     ActivityTracker::updateActivityTime();
     // Allow graceful abort
     if (input == "cancel") {
         throw std::runtime_error("Operation canceled.");
     }
-    size_t index;
-    // Try to convert input to index
+    TaskId id;
+    // Try to convert input to an ID
     try {
-        index = std::stoul(input);
+        id = std::stoull(input);
     }
     catch (...) {
-        std::cout << "Invalid index input.\n";
+        std::cout << "Invalid ID input.\n";
         return;
     }
-    // Bounds check
-    if (index >= manager->getTaskCount()) {
-        std::cout << "Task index out of range.\n";
+    if (!manager->indexOf(id)) {
+        std::cout << "No task with this ID.\n";
         return;
     }
 
-    Task& task = manager->getTaskByIndex(index);
+    // Edit a copy and hand it back, so the manager can keep its indexes in sync
+    Task task = manager->getTask(id).toTask();
 
     std::cout << "\nWhat do you want to edit?\n"
         << "1. Mark as completed/incomplete\n"
@@ -406,8 +535,9 @@ void App::editTask() {
     }
     // Handle selection with user-friendly prompts
     if (input == "1") {
-        task.setCompleted(!task.getCompleted());
+        manager->setCompleted(id, !task.getCompleted());
         std::cout << "✅ Status updated.\n";
+        return;
     }
     else if (input == "2") {
         std::string newTitle = ui.promptForTitle();
@@ -423,6 +553,7 @@ void App::editTask() {
         std::cout << "Unknown option.\n";
         return;
     }
+    manager->editTask(id, task);
 }
 
 void App::printAllTasks() {
@@ -432,11 +563,181 @@ void App::printAllTasks() {
         std::cout << "No tasks found.\n";
         return;
     }
-    // Display every task with its index
-    size_t index = 0; 
+    // Display every task with its ID
+    TaskRenderer renderer = makeRenderer();
     for (const auto& task : manager->getAllTasks()) {
-        std::cout << "[" << index << "] "; 
-        task.print();
-        ++index;
+        if (!renderer.add(task)) break;
+    }
+}
+
+TaskRenderer App::makeRenderer() const {
+    return TaskRenderer(listLayout, pageSize);
+}
+
+// Renders filter/search results
+void App::renderTasks(const TaskView& view) const {
+    TaskRenderer renderer = makeRenderer();
+    for (const auto& entry : view) {
+        if (!renderer.add(entry.task)) break;
+    }
+}
+
+// Lets the user pick how listings are laid out and how many tasks a page holds
+void App::chooseView() {
+    std::string input;
+    std::cout << "Layout\n"
+        << "1. Verbose (one block per task)\n"
+        << "2. Table (one line per task)\n"
+        << "Choose option (or type 'cancel' to abort): ";
+    std::getline(std::cin, input);
+    ActivityTracker::updateActivityTime();
+    if (input == "cancel") throw std::runtime_error("Operation canceled.");
+    if (input == "1") listLayout = TaskRenderer::Layout::Verbose;
+    else if (input == "2") listLayout = TaskRenderer::Layout::Table;
+    else throw std::runtime_error("Unknown layout.");
+
+    std::cout << "Tasks per page, 0 for no paging (or 'cancel' to abort): ";
+    std::getline(std::cin, input);
+    ActivityTracker::updateActivityTime();
+    if (input == "cancel") throw std::runtime_error("Operation canceled.");
+    try {
+        pageSize = std::stoul(input);
+    }
+    catch (...) {
+        throw std::runtime_error("Invalid page size.");
+    }
+    std::cout << "View updated.\n";
+}
+
+// Copies a task file into another format; the backend of each side is picked by extension
+void App::convertStorage() {
+    std::string source, target;
+    std::cout << "Enter source file (or 'cancel' to abort): ";
+    std::getline(std::cin, source);
+    ActivityTracker::updateActivityTime();
+    if (source == "cancel") throw std::runtime_error("Operation canceled.");
+
+    std::cout << "Enter target file, e.g. tasks.snap (or 'cancel' to abort): ";
+    std::getline(std::cin, target);
+    ActivityTracker::updateActivityTime();
+    if (target == "cancel") throw std::runtime_error("Operation canceled.");
+
+    if (!std::filesystem::exists(source)) throw std::runtime_error("File not found: " + source);
+    if (source == target) throw std::runtime_error("Source and target must differ.");
+
+    auto targetStorage = TaskStorage::forFile(target);
+    if (auto* jsonTarget = dynamic_cast<JsonStorage*>(targetStorage.get())) {
+        std::string answer;
+        std::cout << "Store deadlines as epoch seconds for faster loading? (yes/no): ";
+        std::getline(std::cin, answer);
+        ActivityTracker::updateActivityTime();
+        jsonTarget->setDeadlineEncoding(answer == "yes"
+            ? JsonStorage::DeadlineEncoding::EpochSeconds : JsonStorage::DeadlineEncoding::Text);
+    }
+
+    TaskFileExtras extras; // rows keep their positions, so saved index orders carry over as they are
+    auto tasks = TaskStorage::forFile(source)->loadFromFile(source, &extras);
+    reportLoadStats();
+    targetStorage->saveToFile(target, tasks, &extras);
+    std::cout << "🔁 Converted " << tasks.size() << " tasks: " << source << " -> " << target << "\n";
+}
+
+// Appends the tasks of a CSV/NDJSON file; they reach tasks.json with the next save or autosave
+void App::importTasks() {
+    std::string path;
+    std::cout << "Enter file to import, .csv or .ndjson (or 'cancel' to abort): ";
+    std::getline(std::cin, path);
+    ActivityTracker::updateActivityTime();
+    if (path == "cancel") throw std::runtime_error("Operation canceled.");
+
+    ImportStats stats = manager->importTasks(path);
+    std::cout << std::fixed << std::setprecision(1)
+        << "📥 Imported " << stats.imported << " task(s) in " << stats.seconds * 1000.0 << " ms ("
+        << stats.megabytesPerSecond() << " MB/s)\n" << std::defaultfloat;
+    if (stats.skipped > 0) {
+        std::cout << "Skipped " << stats.skipped << " bad row(s), first at " << stats.firstError << "\n";
+    }
+}
+
+void App::exportTasks() {
+    std::string path;
+    std::cout << "Enter file to export to, .csv or .ndjson (or 'cancel' to abort): ";
+    std::getline(std::cin, path);
+    ActivityTracker::updateActivityTime();
+    if (path == "cancel") throw std::runtime_error("Operation canceled.");
+
+    size_t count = manager->exportTasks(path);
+    std::cout << "📤 Exported " << count << " task(s) to " << path << "\n";
+}
+
+// Prints how fast the last load went (tasks, time and throughput)
+void App::reportLoadStats() {
+    const LoadStats& stats = TaskStorage::getLastLoadStats();
+    if (stats.tasks == 0) return;
+
+    std::cout << std::fixed << std::setprecision(1)
+        << "Loaded " << stats.tasks << " tasks in " << stats.seconds * 1000.0 << " ms ("
+        << stats.megabytesPerSecond() << " MB/s)\n\n" << std::defaultfloat;
+}
+
+// Prints the log records between two local times, read from the segmented log via its time index
+void App::showLogs() {
+    auto promptTime = [](const std::string& label, std::chrono::system_clock::time_point fallback) {
+        std::string text;
+        std::cout << label << " (YYYY-MM-DD HH:MM[:SS], empty for default, or 'cancel' to abort): ";
+        std::getline(std::cin, text);
+        ActivityTracker::updateActivityTime();
+        if (text == "cancel") throw std::runtime_error("Operation canceled.");
+        return text.empty() ? fallback : LogReader::parseTimestamp(text);
+    };
+
+    auto now = std::chrono::system_clock::now();
+    auto from = promptTime("From, default 1 hour ago", now - std::chrono::hours(1));
+    auto to = promptTime("To, default now", now);
+
+    auto records = LogReader(logDirectory).read(from, to);
+    for (const auto& record : records) {
+        std::cout << record.timestamp << "  " << record.message << "\n";
     }
-}   
+    std::cout << records.size() << " log record(s).\n";
+}
+
+// Cancels every service's jobs (waiting for running ones), flushes the log, then stops the workers
+void App::stopServices() {
+    reminderService->stop();
+    hintService->stop();
+    autoSaveService->stop();
+    loggerService->stop();
+    scheduler->stop();
+}
+
+// Prints run count, run time and queue delay (due -> started) for each background job, then the logger counters
+void App::printSchedulerStats() {
+    using namespace std::chrono;
+    auto ms = [](Scheduler::Clock::duration d) { return duration<double, std::milli>(d).count(); };
+
+    std::cout << "\nBackground jobs (" << scheduler->getWorkerCount() << " worker threads):\n"
+        << std::left << std::setw(12) << "job" << std::right << std::setw(8) << "runs"
+        << std::setw(12) << "avg ms" << std::setw(12) << "max ms"
+        << std::setw(14) << "avg delay ms" << std::setw(14) << "max delay ms" << "\n";
+
+    std::cout << std::fixed << std::setprecision(3);
+    for (const auto& stats : scheduler->getStats()) {
+        // A job that has not run yet has no averages
+        auto average = [&](Scheduler::Clock::duration total, int width) {
+            std::cout << std::setw(width);
+            if (stats.runs == 0) std::cout << "-";
+            else std::cout << ms(total) / static_cast<double>(stats.runs);
+        };
+        std::cout << std::left << std::setw(12) << stats.name << std::right << std::setw(8) << stats.runs;
+        average(stats.totalRunTime, 12);
+        std::cout << std::setw(12) << ms(stats.maxRunTime);
+        average(stats.totalQueueDelay, 14);
+        std::cout << std::setw(14) << ms(stats.maxQueueDelay) << "\n";
+    }
+    std::cout << std::defaultfloat;
+
+    LoggerService::Counters log = loggerService->getCounters();
+    std::cout << "Log events: " << log.logged << " logged, " << log.written << " written, "
+        << log.queued() << " queued, " << log.dropped << " dropped\n\n";
+}
\ No newline at end of file
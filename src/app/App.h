@@ -1,26 +1,33 @@
 #pragma once
 
 #include "TaskManager.h"
-#include "JsonStorage.h"
 #include "UI.h"
 #include "ReminderService.h"
 #include "HintService.h"
 #include "LoggerService.h"
 #include "AutoSaveService.h"
+#include "Scheduler.h"
+#include "TaskRenderer.h"
 
 class App {
 public:
     void run();
+    // Runs the command line (a subcommand, or --script) without prompts or background services;
+    // args must not be empty. Returns the process exit code.
+    int runBatch(const std::vector<std::string>& args);
 
 private:
     std::shared_ptr<TaskManager> manager = std::make_shared<TaskManager>();
-    JsonStorage storage;
     UI ui;
     const std::string filename = "tasks.json";
+    const std::string logDirectory = "logs";
+    std::shared_ptr<Scheduler> scheduler = std::make_shared<Scheduler>();
     std::unique_ptr<ReminderService> reminderService;
     std::unique_ptr<HintService> hintService;
     std::unique_ptr<LoggerService> loggerService;
     std::unique_ptr<AutoSaveService> autoSaveService;
+    TaskRenderer::Layout listLayout = TaskRenderer::Layout::Verbose;
+    size_t pageSize = 0; // tasks per page in listings; 0 shows everything at once
 
     void showUpcomingDeadlines();
     void showTasksForToday();
@@ -28,4 +35,14 @@ private:
     void showCompletedTasks();
     void editTask();
     void printAllTasks();
+    TaskRenderer makeRenderer() const;
+    void renderTasks(const TaskView& view) const;
+    void chooseView();
+    void reportLoadStats();
+    void convertStorage();
+    void importTasks();
+    void exportTasks();
+    void showLogs();
+    void stopServices();
+    void printSchedulerStats();
 };
\ No newline at end of file
@@ -0,0 +1,237 @@
+#include "BatchRunner.h"
+#include "QueryExecutor.h"
+#include "DateTimeUtils.h"
+#include <stdexcept>
+#include <string>
+
+static Priority parsePriority(const std::string& text) {
+    if (text == "low" || text == "0") return Priority::Low;
+    if (text == "medium" || text == "1") return Priority::Medium;
+    if (text == "high" || text == "2") return Priority::High;
+    throw std::runtime_error("Unknown priority '" + text + "' (low, medium or high)");
+}
+
+static bool parseYesNo(const std::string& key, const std::string& text) {
+    if (text.empty() || text == "yes" || text == "true") return true; // a bare flag means yes
+    if (text == "no" || text == "false") return false;
+    throw std::runtime_error("--" + key + " expects yes or no");
+}
+
+static std::string required(const CommandArgs& args, const std::string& key) {
+    std::string value = args.get(key);
+    if (value.empty()) throw std::runtime_error(args.name + " needs --" + key);
+    return value;
+}
+
+BatchRunner::BatchRunner(TaskManager& manager, std::ostream& out, std::ostream& err)
+    : manager(manager), err(err), renderer(TaskRenderer::Layout::Verbose, 0, out) {
+}
+
+const char* BatchRunner::usage() {
+    return "Usage: task_manager <command> [options]\n"
+        "       task_manager --script <file>   (or '-' / nothing for stdin)\n\n"
+        "Commands:\n"
+        "  add --title T --deadline \"YYYY-MM-DD HH:MM\" [--description D] [--priority low|medium|high] [--tag X] [--completed]\n"
+        "  edit <id> [--title T] [--description D] [--deadline D] [--priority P] [--tag X] [--completed yes|no]\n"
+        "  delete <id>\n"
+        "  complete <id> | reopen <id>\n"
+        "  list [--tag X] [--text W] [--completed yes|no] [--sort deadline|priority|title] [--desc] [--limit N]\n"
+        "  query '<query>'                     e.g. 'tag=work and due within 7d order by deadline'\n"
+        "  overdue | upcoming | today\n"
+        "  next [N]                            the N (default 10) pending tasks to do first, by priority then deadline\n"
+        "  import <file.csv|file.ndjson>       append tasks, streamed and parsed in parallel\n"
+        "  export <file.csv|file.ndjson>\n"
+        "  save\n\n"
+        "Listings take --format text|table|json (default text).\n";
+}
+
+void BatchRunner::execute(const CommandArgs& args) {
+    const std::string& command = args.name;
+
+    if (command == "add") {
+        addTask(args);
+    }
+    else if (command == "edit") {
+        editTask(args);
+    }
+    else if (command == "delete") {
+        TaskId id = idArgument(args);
+        if (!manager.removeTask(id)) throw std::out_of_range("No task with id " + std::to_string(id) + ".");
+        renderer.text("Deleted [" + std::to_string(id) + "]\n");
+    }
+    else if (command == "complete" || command == "reopen") {
+        TaskId id = idArgument(args);
+        if (!manager.setCompleted(id, command == "complete")) throw std::out_of_range("No task with id " + std::to_string(id) + ".");
+        renderer.text((command == "complete" ? "Completed [" : "Reopened [") + std::to_string(id) + "]\n");
+    }
+    else if (command == "list") {
+        listTasks(args);
+    }
+    else if (command == "query") {
+        std::string text;
+        for (const auto& word : args.positional) text += (text.empty() ? "" : " ") + word;
+        runQuery(args, TaskQuery::parse(text));
+    }
+    else if (command == "overdue" || command == "upcoming" || command == "today") {
+        runQuery(args, TaskQuery::parse(command));
+    }
+    else if (command == "next") {
+        nextTasks(args);
+    }
+    else if (command == "import") {
+        if (args.positional.size() != 1) throw std::runtime_error("import needs a file");
+        ImportStats stats = manager.importTasks(args.positional[0]);
+        renderer.text("Imported " + std::to_string(stats.imported) + " task(s), " + std::to_string(stats.skipped) + " skipped\n");
+        if (stats.skipped > 0) renderer.text("First bad row at " + stats.firstError + "\n");
+    }
+    else if (command == "export") {
+        if (args.positional.size() != 1) throw std::runtime_error("export needs a file");
+        size_t count = manager.exportTasks(args.positional[0]);
+        renderer.text("Exported " + std::to_string(count) + " task(s)\n");
+    }
+    else if (command == "save") {
+        manager.commitChanges();
+    }
+    else if (command == "help") {
+        renderer.text(usage());
+    }
+    else {
+        throw std::runtime_error("Unknown command: '" + command + "'");
+    }
+}
+
+BatchRunner::Summary BatchRunner::runScript(std::istream& in) {
+    Summary summary;
+    auto started = std::chrono::steady_clock::now();
+
+    std::string line;
+    size_t lineNumber = 0;
+    while (std::getline(in, line)) {
+        ++lineNumber;
+        try {
+            std::vector<std::string> words = parser.splitWords(line);
+            if (words.empty() || words[0][0] == '#') continue;
+            ++summary.commands;
+            execute(parser.parseArgs(words));
+        }
+        catch (const std::exception& e) {
+            ++summary.failed;
+            renderer.flush(); // keep the error next to the output it follows
+            err << "line " << lineNumber << ": " << e.what() << '\n';
+        }
+    }
+
+    renderer.flush();
+    summary.elapsed = std::chrono::steady_clock::now() - started;
+    return summary;
+}
+
+void BatchRunner::flush() {
+    renderer.flush();
+}
+
+TaskId BatchRunner::idArgument(const CommandArgs& args) const {
+    if (args.positional.size() != 1) throw std::runtime_error(args.name + " needs a task ID");
+    try {
+        size_t consumed = 0;
+        TaskId id = std::stoull(args.positional[0], &consumed);
+        if (consumed == args.positional[0].size()) return id;
+    }
+    catch (const std::exception&) {
+    }
+    throw std::runtime_error("Invalid ID '" + args.positional[0] + "'");
+}
+
+void BatchRunner::addTask(const CommandArgs& args) {
+    Task task(required(args, "title"),
+        args.get("description"),
+        DateTimeUtils::stringToTimePoint(required(args, "deadline")),
+        parsePriority(parser.toLower(args.get("priority", "low"))),
+        args.get("tag"),
+        args.has("completed") && parseYesNo("completed", args.get("completed")));
+    TaskId id = manager.addTask(task);
+    renderer.text("Added [" + std::to_string(id) + "]\n");
+}
+
+// Options that are not given keep the task's current value
+void BatchRunner::editTask(const CommandArgs& args) {
+    TaskId id = idArgument(args);
+    TaskRef current = manager.getTask(id);
+
+    Task task(args.has("title") ? required(args, "title") : std::string(current.getTitle()),
+        args.has("description") ? args.get("description") : std::string(current.getDescription()),
+        args.has("deadline") ? DateTimeUtils::stringToTimePoint(args.get("deadline")) : current.getDeadline(),
+        args.has("priority") ? parsePriority(parser.toLower(args.get("priority"))) : current.getPriority(),
+        args.has("tag") ? args.get("tag") : std::string(current.getTag()),
+        args.has("completed") ? parseYesNo("completed", args.get("completed")) : current.getCompleted());
+    manager.editTask(id, task);
+    renderer.text("Edited [" + std::to_string(id) + "]\n");
+}
+
+// Options map onto a TaskQuery, so list is answered by the same indexes as query
+void BatchRunner::listTasks(const CommandArgs& args) {
+    TaskQuery query;
+    if (args.has("tag")) query.tags.push_back(parser.toLower(args.get("tag")));
+    if (args.has("text")) query.keywords.push_back(parser.toLower(required(args, "text")));
+    if (args.has("completed")) query.completed = parseYesNo("completed", args.get("completed"));
+
+    std::string sort = parser.toLower(args.get("sort"));
+    if (sort == "deadline") query.orderBy = TaskQuery::OrderField::Deadline;
+    else if (sort == "priority") query.orderBy = TaskQuery::OrderField::Priority;
+    else if (sort == "title") query.orderBy = TaskQuery::OrderField::Title;
+    else if (!sort.empty()) throw std::runtime_error("--sort expects deadline, priority or title");
+    query.descending = args.has("desc");
+
+    if (args.has("limit")) {
+        try {
+            query.limit = std::stoul(args.get("limit"));
+        }
+        catch (const std::exception&) {
+            throw std::runtime_error("--limit expects a number");
+        }
+    }
+    runQuery(args, query);
+}
+
+// Answered from the head of the priority index, whatever the number of tasks
+void BatchRunner::nextTasks(const CommandArgs& args) {
+    TaskQuery query;
+    query.completed = false;
+    query.orderBy = TaskQuery::OrderField::Priority;
+    query.descending = true;
+    query.limit = 10;
+    if (args.positional.size() > 1) throw std::runtime_error("next takes at most one count");
+    if (!args.positional.empty()) {
+        try {
+            query.limit = std::stoul(args.positional[0]);
+        }
+        catch (const std::exception&) {
+            throw std::runtime_error("next expects a number of tasks");
+        }
+    }
+    runQuery(args, query);
+}
+
+void BatchRunner::runQuery(const CommandArgs& args, const TaskQuery& query) {
+    std::string format = parser.toLower(args.get("format", "text"));
+    if (format != "text" && format != "table" && format != "json") {
+        throw std::runtime_error("--format expects text, table or json");
+    }
+
+    QueryResult result = QueryExecutor::run(manager, query);
+    if (format == "json") {
+        // One array per listing, each task as stored in tasks.json (id included)
+        bool first = true;
+        renderer.text("[");
+        for (const auto& entry : result.rows) {
+            nlohmann::json row = entry.task;
+            renderer.text((first ? "\n" : ",\n") + row.dump());
+            first = false;
+        }
+        renderer.text("\n]\n");
+        return;
+    }
+
+    renderer.setLayout(format == "table" ? TaskRenderer::Layout::Table : TaskRenderer::Layout::Verbose);
+    for (const auto& entry : result.rows) renderer.add(entry.task);
+}
\ No newline at end of file
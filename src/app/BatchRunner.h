@@ -0,0 +1,43 @@
+#pragma once
+
+#include "TaskManager.h"
+#include "TaskQuery.h"
+#include "TaskRenderer.h"
+#include "CommandParser.h"
+#include <chrono>
+#include <iostream>
+
+// Runs commands given as words (argv or script lines) without any prompts. Nothing is
+// saved per command: mutations only go to the journal buffer and the caller commits once.
+class BatchRunner {
+public:
+    struct Summary {
+        size_t commands = 0;
+        size_t failed = 0;
+        std::chrono::steady_clock::duration elapsed{};
+    };
+
+    explicit BatchRunner(TaskManager& manager, std::ostream& out = std::cout, std::ostream& err = std::cerr);
+
+    // Throws std::runtime_error (or std::out_of_range for an unknown task ID) when the command fails
+    void execute(const CommandArgs& args);
+    // One command per line; blank lines and lines starting with '#' are skipped.
+    // A failing command is reported with its line number and the script goes on.
+    Summary runScript(std::istream& in);
+    void flush();
+
+    static const char* usage();
+
+private:
+    void addTask(const CommandArgs& args);
+    void editTask(const CommandArgs& args);
+    void listTasks(const CommandArgs& args);
+    void nextTasks(const CommandArgs& args);
+    void runQuery(const CommandArgs& args, const TaskQuery& query);
+    TaskId idArgument(const CommandArgs& args) const;
+
+    TaskManager& manager;
+    std::ostream& err;
+    TaskRenderer renderer;
+    CommandParser parser;
+};
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include <algorithm>
 #include <cctype>
 #include <sstream>
+#include <stdexcept>
 
 // Func for delete spaces
 static std::string trim(const std::string& str) {
@@ -19,7 +20,89 @@ std::string CommandParser::toLower(const std::string& str) const{
     return result;
 }
 
+// Case-insensitive substring test against an already lowercased needle (no allocation)
+bool CommandParser::containsIgnoreCase(std::string_view haystack, const std::string& loweredNeedle) const {
+    auto it = std::search(haystack.begin(), haystack.end(), loweredNeedle.begin(), loweredNeedle.end(),
+        [](char a, char b) { return std::tolower(static_cast<unsigned char>(a)) == b; });
+    return it != haystack.end();
+}
+
 std::string CommandParser::parse(const std::string& input) const {
     std::string command = trim(input);
     return toLower(command);
+}
+
+std::vector<std::string> CommandParser::splitWords(const std::string& line) const {
+    std::vector<std::string> words;
+    std::string word;
+    bool inWord = false;
+    char quote = 0;
+
+    for (size_t i = 0; i < line.size(); ++i) {
+        char c = line[i];
+        if (quote == '\'') {
+            if (c == '\'') quote = 0;
+            else word += c;
+        }
+        else if (c == '\\' && i + 1 < line.size()) {
+            word += line[++i];
+            inWord = true;
+        }
+        else if (quote == '"') {
+            if (c == '"') quote = 0;
+            else word += c;
+        }
+        else if (c == '"' || c == '\'') {
+            quote = c;
+            inWord = true;
+        }
+        else if (c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+            if (inWord) words.push_back(std::move(word));
+            word.clear();
+            inWord = false;
+        }
+        else {
+            word += c;
+            inWord = true;
+        }
+    }
+
+    if (quote != 0) throw std::runtime_error("Unterminated quote");
+    if (inWord) words.push_back(std::move(word));
+    return words;
+}
+
+CommandArgs CommandParser::parseArgs(const std::vector<std::string>& words) const {
+    CommandArgs args;
+    if (words.empty()) return args;
+
+    args.name = toLower(words[0]);
+    for (size_t i = 1; i < words.size(); ++i) {
+        const std::string& word = words[i];
+        if (word.size() <= 2 || word.compare(0, 2, "--") != 0) {
+            args.positional.push_back(word);
+            continue;
+        }
+
+        size_t equals = word.find('=');
+        if (equals != std::string::npos) {
+            args.options[word.substr(2, equals - 2)] = word.substr(equals + 1);
+        }
+        else if (i + 1 < words.size() && words[i + 1].compare(0, 2, "--") != 0) {
+            args.options[word.substr(2)] = words[++i];
+        }
+        else {
+            args.options[word.substr(2)] = "";
+        }
+    }
+    return args;
+}
+
+bool CommandArgs::has(const std::string& key) const {
+    return options.count(key) > 0;
+}
+
+std::string CommandArgs::get(const std::string& key, const std::string& fallback) const {
+    auto it = options.find(key);
+    return it == options.end() ? fallback : it->second;
 }
\ No newline at end of file
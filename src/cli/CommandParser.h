@@ -1,8 +1,28 @@
 #pragma once
+#include <map>
 #include <string>
+#include <string_view>
+#include <vector>
+
+// A command given as words (from argv or a script line), e.g.
+//   add --title "Buy milk" --deadline "2026-05-01 18:00" --tag home
+// "--key value" and "--key=value" are options; "--key" followed by nothing or another option is a flag
+struct CommandArgs {
+    std::string name;
+    std::vector<std::string> positional;
+    std::map<std::string, std::string> options;
+
+    bool has(const std::string& key) const;
+    std::string get(const std::string& key, const std::string& fallback = "") const;
+};
 
 class CommandParser {
 public:
     std::string parse(const std::string& input) const;
     std::string toLower(const std::string& str) const;
+    bool containsIgnoreCase(std::string_view haystack, const std::string& loweredNeedle) const;
+    // Splits a line into words like a shell would: blanks separate words, quotes group them,
+    // and a backslash escapes the next character outside single quotes. Throws std::runtime_error.
+    std::vector<std::string> splitWords(const std::string& line) const;
+    CommandArgs parseArgs(const std::vector<std::string>& words) const;
 };
\ No newline at end of file
@@ -0,0 +1,155 @@
+#include "TaskRenderer.h"
+#include "DateTimeUtils.h"
+#include "ActivityTracker.h"
+
+static constexpr size_t flushBytes = 64 * 1024;
+static constexpr size_t tagWidth = 12;
+
+static const char* priorityName(Priority priority) {
+    switch (priority) {
+    case Priority::Low: return "Low";
+    case Priority::Medium: return "Medium";
+    case Priority::High: return "High";
+    }
+    return "";
+}
+
+static void appendNumber(std::string& out, uint64_t value) {
+    char digits[24];
+    int length = 0;
+    do {
+        digits[length++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    while (length > 0) out += digits[--length];
+}
+
+// Pads (or cuts, marking the cut with '~') text to exactly width bytes
+static void appendPadded(std::string& out, std::string_view text, size_t width) {
+    if (text.size() > width) {
+        out.append(text.data(), width - 1);
+        out += '~';
+        return;
+    }
+    out += text;
+    out.append(width - text.size(), ' ');
+}
+
+TaskRenderer::TaskRenderer(Layout layout, size_t pageSize, std::ostream& out, std::istream& in)
+    : layout(layout), pageSize(pageSize), out(out), in(in) {
+    buffer.reserve(flushBytes + 1024);
+}
+
+TaskRenderer::~TaskRenderer() {
+    flush();
+}
+
+void TaskRenderer::setLayout(Layout newLayout) {
+    layout = newLayout;
+    headerShown = false;
+}
+
+void TaskRenderer::text(const std::string& line) {
+    buffer += line;
+    if (buffer.size() >= flushBytes) flush();
+}
+
+void TaskRenderer::flush() {
+    if (buffer.empty()) return;
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    out.flush();
+    buffer.clear(); // keeps its capacity for the next chunk
+}
+
+size_t TaskRenderer::getRendered() const {
+    return rendered;
+}
+
+bool TaskRenderer::isStopped() const {
+    return stopped;
+}
+
+template <typename Row>
+void TaskRenderer::appendVerbose(const Row& task) {
+    if (task.getId() != 0) {
+        buffer += '[';
+        appendNumber(buffer, task.getId());
+        buffer += "] ";
+    }
+    buffer += task.getCompleted() ? "[+] " : "[ ] ";
+    buffer += "Title: ";
+    buffer += task.getTitle();
+    buffer += "\nDescription: ";
+    buffer += task.getDescription();
+    buffer += "\nDeadline: ";
+    DateTimeUtils::appendTimePoint(buffer, task.getDeadline(), false);
+    buffer += "\nPriority: ";
+    buffer += priorityName(task.getPriority());
+    buffer += "\nTag: ";
+    buffer += task.getTag();
+    buffer += "\n\n";
+}
+
+template <typename Row>
+void TaskRenderer::appendTable(const Row& task) {
+    if (!headerShown) {
+        buffer += "     ID     Deadline          Priority  Tag           Title\n";
+        headerShown = true;
+    }
+
+    size_t start = buffer.size();
+    if (task.getId() != 0) appendNumber(buffer, task.getId());
+    if (buffer.size() - start < 7) buffer.insert(start, 7 - (buffer.size() - start), ' '); // right-aligned
+    buffer += task.getCompleted() ? " [+] " : " [ ] ";
+    DateTimeUtils::appendTimePoint(buffer, task.getDeadline(), false);
+    buffer += "  ";
+    appendPadded(buffer, priorityName(task.getPriority()), 8);
+    buffer += "  ";
+    appendPadded(buffer, task.getTag(), tagWidth);
+    buffer += "  ";
+    buffer += task.getTitle();
+    buffer += '\n';
+}
+
+template <typename Row>
+bool TaskRenderer::addRow(const Row& task) {
+    if (stopped) return false;
+    if (pageSize > 0 && rendered > 0 && rendered % pageSize == 0 && !pageBreak()) return false;
+
+    if (layout == Layout::Table) appendTable(task);
+    else appendVerbose(task);
+    ++rendered;
+
+    if (buffer.size() >= flushBytes) flush();
+    return true;
+}
+
+bool TaskRenderer::add(const Task& task) {
+    return addRow(task);
+}
+
+bool TaskRenderer::add(const TaskRef& task) {
+    return addRow(task);
+}
+
+// Shows what has been rendered so far and asks whether to go on. End of input turns
+// paging off rather than stopping, so piped input still gets the whole listing.
+bool TaskRenderer::pageBreak() {
+    buffer += "-- ";
+    appendNumber(buffer, rendered);
+    buffer += " shown, Enter for more, 'q' to stop -- ";
+    flush();
+
+    std::string answer;
+    if (!std::getline(in, answer)) {
+        pageSize = 0;
+        return true;
+    }
+    ActivityTracker::updateActivityTime();
+    if (answer == "q" || answer == "cancel") {
+        stopped = true;
+        return false;
+    }
+    headerShown = false; // repeat the table header on every page
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Task.h"
+#include "TaskTable.h"
+#include <cstddef>
+#include <iostream>
+#include <string>
+
+// Formats task listings into one reusable buffer and writes it out in large chunks,
+// instead of a dozen small stream operations per task. Optionally pauses every
+// pageSize tasks and waits for the user before going on.
+class TaskRenderer {
+public:
+    enum class Layout {
+        Verbose, // the multi-line block Task::print has always shown
+        Table    // one line per task
+    };
+
+    explicit TaskRenderer(Layout layout = Layout::Verbose, size_t pageSize = 0,
+        std::ostream& out = std::cout, std::istream& in = std::cin);
+    TaskRenderer(const TaskRenderer&) = delete;
+    TaskRenderer& operator=(const TaskRenderer&) = delete;
+    ~TaskRenderer();
+
+    // Switches layout for the next tasks; a table starts over with its header
+    void setLayout(Layout newLayout);
+    // Appends one task, prefixed with its id if it has one. Returns false once the user
+    // has stopped the pager; the task is then not rendered.
+    bool add(const Task& task);
+    bool add(const TaskRef& task);
+    // Appends free text (headers, separators) to the same buffer
+    void text(const std::string& line);
+    // Writes everything buffered so far
+    void flush();
+
+    size_t getRendered() const;
+    bool isStopped() const;
+
+private:
+    // Row is Task or TaskRef, which share their getters
+    template <typename Row> bool addRow(const Row& task);
+    template <typename Row> void appendVerbose(const Row& task);
+    template <typename Row> void appendTable(const Row& task);
+    bool pageBreak();
+
+    Layout layout;
+    size_t pageSize;
+    std::ostream& out;
+    std::istream& in;
+    std::string buffer;
+    size_t rendered = 0;
+    bool headerShown = false;
+    bool stopped = false;
+};
\ No newline at end of file
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// A column of values split into fixed-size pages held by shared_ptr, like StringArena's chunks.
+// Copying a column copies only the page pointers. A write to a page that another copy still
+// holds copies that one page first, so copying a table and then editing a row costs one page
+// per column the edit touches. Pages never move, so each can be handed to a vectorized scan.
+template <typename T, size_t PageShift>
+class ChunkedColumn {
+public:
+    static constexpr size_t pageSize = size_t(1) << PageShift;
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const T& operator[](size_t index) const { return pages[index >> PageShift][index & (pageSize - 1)]; }
+    const T& back() const { return (*this)[count - 1]; }
+
+    // The value at index, for writing; copies its page first if another column shares it
+    T& writable(size_t index) { return writablePage(index >> PageShift)[index & (pageSize - 1)]; }
+
+    void push_back(const T& value) {
+        if (count % pageSize == 0) pages.emplace_back(new T[pageSize]);
+        writable(count) = value;
+        ++count;
+    }
+    void pop_back() {
+        if (--count % pageSize == 0) pages.pop_back();
+    }
+    void reserve(size_t values) { pages.reserve((values + pageSize - 1) / pageSize); }
+    void clear() {
+        pages.clear();
+        count = 0;
+    }
+
+    size_t pageCount() const { return pages.size(); }
+    const T* page(size_t number) const { return pages[number].get(); }
+    size_t pageLength(size_t number) const { return std::min(pageSize, count - number * pageSize); }
+
+private:
+    // Copying a column must not race with writing it (TaskManager does both under its state
+    // mutex), so a page only this column holds cannot gain a holder meanwhile. A stale count
+    // from a copy being dropped on another thread only costs a needless page copy.
+    T* writablePage(size_t number) {
+        std::shared_ptr<T[]>& current = pages[number];
+        if (current.use_count() > 1) {
+            std::shared_ptr<T[]> copy(new T[pageSize]);
+            std::copy(current.get(), current.get() + pageLength(number), copy.get());
+            current = std::move(copy);
+        }
+        return current.get();
+    }
+
+    std::vector<std::shared_ptr<T[]>> pages;
+    size_t count = 0;
+};
\ No newline at end of file
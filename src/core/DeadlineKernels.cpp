@@ -0,0 +1,211 @@
+#include "DeadlineKernels.h"
+#include <bitset>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define DEADLINE_KERNELS_X86 1
+#include <emmintrin.h>
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Scalar and SSE2 kernels, CPU detection and dispatch. The AVX2 kernel lives in
+// DeadlineKernelsAvx2.cpp, the only file built with AVX2 enabled.
+
+namespace DeadlineKernels {
+    namespace detail {
+        unsigned popcount(uint64_t word) {
+            return static_cast<unsigned>(std::bitset<64>(word).count());
+        }
+
+        unsigned lowestBit(uint64_t word) {
+#ifdef _MSC_VER
+            unsigned long index;
+            _BitScanForward64(&index, word);
+            return static_cast<unsigned>(index);
+#else
+            return static_cast<unsigned>(__builtin_ctzll(word));
+#endif
+        }
+
+        // Builds each 64-row "due" word without branches, then drops the completed rows
+        size_t scanScalar(const int64_t* deadlines, const uint64_t* completed, size_t count,
+            uint64_t from, uint64_t width, uint64_t* selected) {
+            size_t total = 0;
+            for (size_t word = 0; word * 64 < count; ++word) {
+                size_t first = word * 64;
+                size_t rows = count - first < 64 ? count - first : 64;
+                uint64_t due = 0;
+                for (size_t bit = 0; bit < rows; ++bit) {
+                    uint64_t offset = static_cast<uint64_t>(deadlines[first + bit]) - from;
+                    due |= static_cast<uint64_t>(offset <= width) << bit;
+                }
+                due &= ~completed[word];
+                if (selected) selected[word] = due;
+                total += popcount(due);
+            }
+            return total;
+        }
+
+#ifdef DEADLINE_KERNELS_X86
+        // SSE2 has no 64-bit compare, so "a > b" (unsigned) is put together from the signed
+        // 32-bit compares: flipping the sign bits makes them unsigned, the high halves decide
+        // unless equal, and then the low halves do
+        static inline __m128i greaterUnsigned64(__m128i a, __m128i b) {
+            const __m128i flip = _mm_set1_epi32(INT32_MIN);
+            a = _mm_xor_si128(a, flip);
+            b = _mm_xor_si128(b, flip);
+            __m128i greater = _mm_cmpgt_epi32(a, b);
+            __m128i equal = _mm_cmpeq_epi32(a, b);
+            __m128i lowGreater = _mm_shuffle_epi32(greater, _MM_SHUFFLE(2, 2, 0, 0));
+            __m128i result = _mm_or_si128(greater, _mm_and_si128(equal, lowGreater));
+            return _mm_shuffle_epi32(result, _MM_SHUFFLE(3, 3, 1, 1));
+        }
+
+        size_t scanSse2(const int64_t* deadlines, const uint64_t* completed, size_t count,
+            uint64_t from, uint64_t width, uint64_t* selected) {
+            const __m128i fromVector = _mm_set1_epi64x(static_cast<long long>(from));
+            const __m128i widthVector = _mm_set1_epi64x(static_cast<long long>(width));
+            const size_t fullWords = count / 64;
+
+            size_t total = 0;
+            for (size_t word = 0; word < fullWords; ++word) {
+                const int64_t* block = deadlines + word * 64;
+                uint64_t due = 0;
+                for (size_t pair = 0; pair < 32; ++pair) {
+                    __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 2 * pair));
+                    __m128i late = greaterUnsigned64(_mm_sub_epi64(values, fromVector), widthVector);
+                    unsigned outside = static_cast<unsigned>(_mm_movemask_pd(_mm_castsi128_pd(late)));
+                    due |= static_cast<uint64_t>(~outside & 3u) << (2 * pair);
+                }
+                due &= ~completed[word];
+                if (selected) selected[word] = due;
+                total += popcount(due);
+            }
+
+            size_t done = fullWords * 64;
+            return total + scanScalar(deadlines + done, completed + fullWords, count - done, from, width,
+                selected ? selected + fullWords : nullptr);
+        }
+#else
+        size_t scanSse2(const int64_t* deadlines, const uint64_t* completed, size_t count,
+            uint64_t from, uint64_t width, uint64_t* selected) {
+            return scanScalar(deadlines, completed, count, from, width, selected);
+        }
+#endif
+    }
+
+    namespace {
+        bool cpuHasAvx2() {
+#if !defined(DEADLINE_KERNELS_X86)
+            return false;
+#elif defined(_MSC_VER)
+            int info[4];
+            __cpuid(info, 0);
+            if (info[0] < 7) return false;
+            __cpuid(info, 1);
+            const bool osSavesAvx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0
+                && (_xgetbv(0) & 6) == 6; // the OS preserves the YMM registers
+            if (!osSavesAvx) return false;
+            __cpuidex(info, 7, 0);
+            return (info[1] & (1 << 5)) != 0;
+#else
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2"); // also checks that the OS enabled AVX state
+#endif
+        }
+
+        bool cpuHasSse2() {
+#if defined(__x86_64__) || defined(_M_X64)
+            return true; // part of x86-64 itself
+#elif defined(_MSC_VER) && defined(DEADLINE_KERNELS_X86)
+            int info[4];
+            __cpuid(info, 1);
+            return (info[3] & (1 << 26)) != 0;
+#elif defined(DEADLINE_KERNELS_X86)
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("sse2");
+#else
+            return false;
+#endif
+        }
+
+        struct Dispatch {
+            Level level;
+            size_t (*scan)(const int64_t*, const uint64_t*, size_t, uint64_t, uint64_t, uint64_t*);
+        };
+
+        const Dispatch& dispatch() {
+            static const Dispatch chosen = []() {
+                if (isSupported(Level::Avx2)) return Dispatch{ Level::Avx2, detail::scanAvx2 };
+                if (isSupported(Level::Sse2)) return Dispatch{ Level::Sse2, detail::scanSse2 };
+                return Dispatch{ Level::Scalar, detail::scanScalar };
+            }();
+            return chosen;
+        }
+
+        auto scanFor(Level level) {
+            switch (level) {
+            case Level::Avx2: return detail::scanAvx2;
+            case Level::Sse2: return detail::scanSse2;
+            case Level::Scalar: break;
+            }
+            return detail::scanScalar;
+        }
+
+        // Empty windows select nothing; the kernels need from <= to for the unsigned trick
+        size_t run(size_t (*scan)(const int64_t*, const uint64_t*, size_t, uint64_t, uint64_t, uint64_t*),
+            const int64_t* deadlines, const uint64_t* completed, size_t count, int64_t from, int64_t to, uint64_t* selected) {
+            if (to < from) {
+                for (size_t word = 0; selected && word * 64 < count; ++word) selected[word] = 0;
+                return 0;
+            }
+            uint64_t width = static_cast<uint64_t>(to) - static_cast<uint64_t>(from);
+            return scan(deadlines, completed, count, static_cast<uint64_t>(from), width, selected);
+        }
+    }
+
+    bool isSupported(Level level) {
+        static const bool sse2 = cpuHasSse2();
+        static const bool avx2 = sse2 && detail::avx2Built() && cpuHasAvx2();
+        switch (level) {
+        case Level::Avx2: return avx2;
+        case Level::Sse2: return sse2;
+        case Level::Scalar: break;
+        }
+        return true;
+    }
+
+    Level bestLevel() {
+        return dispatch().level;
+    }
+
+    const char* levelName(Level level) {
+        switch (level) {
+        case Level::Avx2: return "avx2";
+        case Level::Sse2: return "sse2";
+        case Level::Scalar: break;
+        }
+        return "scalar";
+    }
+
+    size_t countIncompleteDue(const int64_t* deadlines, const uint64_t* completed, size_t count,
+        int64_t from, int64_t to) {
+        return run(dispatch().scan, deadlines, completed, count, from, to, nullptr);
+    }
+
+    size_t selectIncompleteDue(const int64_t* deadlines, const uint64_t* completed, size_t count,
+        int64_t from, int64_t to, uint64_t* selected) {
+        return run(dispatch().scan, deadlines, completed, count, from, to, selected);
+    }
+
+    size_t countIncompleteDue(Level level, const int64_t* deadlines, const uint64_t* completed, size_t count,
+        int64_t from, int64_t to) {
+        return run(scanFor(level), deadlines, completed, count, from, to, nullptr);
+    }
+
+    size_t selectIncompleteDue(Level level, const int64_t* deadlines, const uint64_t* completed, size_t count,
+        int64_t from, int64_t to, uint64_t* selected) {
+        return run(scanFor(level), deadlines, completed, count, from, to, selected);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Scans over a packed deadline column and a completion bitset (bit i of completed[i / 64]
+// is set when task i is completed) for the incomplete tasks due within [from, to].
+// Every kernel exists as scalar, SSE2 and AVX2 code; the widest one the CPU supports is
+// picked once at runtime.
+namespace DeadlineKernels {
+    enum class Level { Scalar, Sse2, Avx2 };
+
+    // Widest level both this build and this CPU support
+    Level bestLevel();
+    bool isSupported(Level level);
+    const char* levelName(Level level);
+
+    // Number of rows with from <= deadlines[i] <= to whose completion bit is clear
+    size_t countIncompleteDue(const int64_t* deadlines, const uint64_t* completed, size_t count,
+        int64_t from, int64_t to);
+    // The same rows as a selection bitmap: bit i of selected[i / 64] is set for each of them and
+    // every other bit is cleared. selected must hold (count + 63) / 64 words. Returns the count.
+    size_t selectIncompleteDue(const int64_t* deadlines, const uint64_t* completed, size_t count,
+        int64_t from, int64_t to, uint64_t* selected);
+
+    // The same kernels at a fixed level (which must be supported), for checks and benchmarks
+    size_t countIncompleteDue(Level level, const int64_t* deadlines, const uint64_t* completed, size_t count,
+        int64_t from, int64_t to);
+    size_t selectIncompleteDue(Level level, const int64_t* deadlines, const uint64_t* completed, size_t count,
+        int64_t from, int64_t to, uint64_t* selected);
+
+    namespace detail {
+        // One implementation per level; selected may be null when only the count is wanted.
+        // A row is due when deadline - from, as an unsigned number, is at most width = to - from.
+        size_t scanScalar(const int64_t* deadlines, const uint64_t* completed, size_t count,
+            uint64_t from, uint64_t width, uint64_t* selected);
+        size_t scanSse2(const int64_t* deadlines, const uint64_t* completed, size_t count,
+            uint64_t from, uint64_t width, uint64_t* selected);
+        size_t scanAvx2(const int64_t* deadlines, const uint64_t* completed, size_t count,
+            uint64_t from, uint64_t width, uint64_t* selected);
+        // False when the compiler could not build the AVX2 kernel (non-x86 targets)
+        bool avx2Built();
+        unsigned popcount(uint64_t word);
+        unsigned lowestBit(uint64_t word); // word must not be 0
+    }
+
+    // Calls visit(i) for every row i set in a selection bitmap, ascending
+    template <typename Visit>
+    void forEachSelected(const uint64_t* selected, size_t words, Visit&& visit) {
+        for (size_t word = 0; word < words; ++word) {
+            for (uint64_t bits = selected[word]; bits != 0; bits &= bits - 1) {
+                visit(word * 64 + detail::lowestBit(bits));
+            }
+        }
+    }
+}
\ No newline at end of file
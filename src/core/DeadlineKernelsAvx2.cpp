@@ -0,0 +1,58 @@
+#include "DeadlineKernels.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// AVX2 kernel. This file alone is compiled with AVX2 enabled, and it is only called once
+// the CPU check passed; so it stays clear of inline library code, whose AVX2 copy the
+// linker could otherwise hand to callers on any CPU.
+
+namespace DeadlineKernels {
+    namespace detail {
+#if defined(__AVX2__)
+        bool avx2Built() {
+            return true;
+        }
+
+        // Four rows per compare. Biasing both sides by the sign bit turns the signed 64-bit
+        // compare AVX2 has into the unsigned "offset > width" test.
+        size_t scanAvx2(const int64_t* deadlines, const uint64_t* completed, size_t count,
+            uint64_t from, uint64_t width, uint64_t* selected) {
+            const __m256i bias = _mm256_set1_epi64x(INT64_MIN);
+            const __m256i fromVector = _mm256_set1_epi64x(static_cast<long long>(from));
+            const __m256i widthBiased = _mm256_xor_si256(_mm256_set1_epi64x(static_cast<long long>(width)), bias);
+            const size_t fullWords = count / 64;
+
+            size_t total = 0;
+            for (size_t word = 0; word < fullWords; ++word) {
+                const int64_t* block = deadlines + word * 64;
+                uint64_t due = 0;
+                for (size_t quad = 0; quad < 16; ++quad) {
+                    __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 4 * quad));
+                    __m256i offset = _mm256_xor_si256(_mm256_sub_epi64(values, fromVector), bias);
+                    __m256i late = _mm256_cmpgt_epi64(offset, widthBiased);
+                    unsigned outside = static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(late)));
+                    due |= static_cast<uint64_t>(~outside & 15u) << (4 * quad);
+                }
+                due &= ~completed[word];
+                if (selected) selected[word] = due;
+                total += popcount(due);
+            }
+
+            size_t done = fullWords * 64;
+            return total + scanScalar(deadlines + done, completed + fullWords, count - done, from, width,
+                selected ? selected + fullWords : nullptr);
+        }
+#else
+        bool avx2Built() {
+            return false;
+        }
+
+        size_t scanAvx2(const int64_t* deadlines, const uint64_t* completed, size_t count,
+            uint64_t from, uint64_t width, uint64_t* selected) {
+            return scanScalar(deadlines, completed, count, from, width, selected);
+        }
+#endif
+    }
+}
\ No newline at end of file
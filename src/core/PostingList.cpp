@@ -0,0 +1,193 @@
+#include "PostingList.h"
+#include <algorithm>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Chunked array/bitmap posting list
+
+static unsigned lowestBit(uint64_t word) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctzll(word));
+#endif
+}
+
+std::vector<PostingList::Chunk>::iterator PostingList::findChunk(uint32_t key) {
+    return std::lower_bound(chunks.begin(), chunks.end(), key,
+        [](const Chunk& chunk, uint32_t value) { return chunk.key < value; });
+}
+
+std::vector<PostingList::Chunk>::const_iterator PostingList::findChunk(uint32_t key) const {
+    return std::lower_bound(chunks.begin(), chunks.end(), key,
+        [](const Chunk& chunk, uint32_t value) { return chunk.key < value; });
+}
+
+bool PostingList::chunkContains(const Chunk& chunk, uint16_t offset) {
+    if (!chunk.bitmap.empty()) return (chunk.bitmap[offset >> 6] >> (offset & 63)) & 1;
+    return std::binary_search(chunk.array.begin(), chunk.array.end(), offset);
+}
+
+void PostingList::toBitmap(Chunk& chunk) {
+    chunk.bitmap.assign(bitmapWords, 0);
+    for (uint16_t offset : chunk.array) chunk.bitmap[offset >> 6] |= uint64_t(1) << (offset & 63);
+    std::vector<uint16_t>().swap(chunk.array);
+}
+
+void PostingList::toArray(Chunk& chunk) {
+    chunk.array.reserve(chunk.count);
+    for (size_t word = 0; word < bitmapWords; ++word) {
+        for (uint64_t bits = chunk.bitmap[word]; bits != 0; bits &= bits - 1) {
+            chunk.array.push_back(static_cast<uint16_t>(word * 64 + lowestBit(bits)));
+        }
+    }
+    std::vector<uint64_t>().swap(chunk.bitmap);
+}
+
+void PostingList::insert(size_t position) {
+    uint32_t key = static_cast<uint32_t>(position >> 16);
+    uint16_t offset = static_cast<uint16_t>(position & 0xFFFF);
+
+    auto chunk = findChunk(key);
+    if (chunk == chunks.end() || chunk->key != key) {
+        chunk = chunks.insert(chunk, Chunk{});
+        chunk->key = key;
+    }
+
+    if (chunk->bitmap.empty()) {
+        auto& array = chunk->array;
+        // Positions mostly arrive in ascending order, so this is usually a push_back
+        auto at = !array.empty() && array.back() < offset ? array.end() : std::lower_bound(array.begin(), array.end(), offset);
+        if (at != array.end() && *at == offset) return;
+        if (array.size() < arrayLimit) {
+            array.insert(at, offset);
+            ++chunk->count;
+            ++total;
+            return;
+        }
+        toBitmap(*chunk);
+    }
+
+    uint64_t& word = chunk->bitmap[offset >> 6];
+    uint64_t bit = uint64_t(1) << (offset & 63);
+    if (word & bit) return;
+    word |= bit;
+    ++chunk->count;
+    ++total;
+}
+
+void PostingList::erase(size_t position) {
+    uint32_t key = static_cast<uint32_t>(position >> 16);
+    uint16_t offset = static_cast<uint16_t>(position & 0xFFFF);
+
+    auto chunk = findChunk(key);
+    if (chunk == chunks.end() || chunk->key != key) return;
+
+    if (chunk->bitmap.empty()) {
+        auto& array = chunk->array;
+        auto at = !array.empty() && array.back() == offset ? array.end() - 1 : std::lower_bound(array.begin(), array.end(), offset);
+        if (at == array.end() || *at != offset) return;
+        array.erase(at);
+    }
+    else {
+        uint64_t& word = chunk->bitmap[offset >> 6];
+        uint64_t bit = uint64_t(1) << (offset & 63);
+        if (!(word & bit)) return;
+        word &= ~bit;
+        // Half the conversion threshold, so a chunk at the boundary does not flip on every change
+        if (chunk->count - 1 <= arrayLimit / 2) {
+            --chunk->count;
+            --total;
+            toArray(*chunk);
+            return;
+        }
+    }
+
+    --total;
+    if (--chunk->count == 0) chunks.erase(chunk);
+}
+
+bool PostingList::contains(size_t position) const {
+    uint32_t key = static_cast<uint32_t>(position >> 16);
+    auto chunk = findChunk(key);
+    return chunk != chunks.end() && chunk->key == key && chunkContains(*chunk, static_cast<uint16_t>(position & 0xFFFF));
+}
+
+size_t PostingList::size() const {
+    return total;
+}
+
+bool PostingList::empty() const {
+    return total == 0;
+}
+
+void PostingList::appendTo(std::vector<size_t>& out) const {
+    out.reserve(out.size() + total);
+    for (const Chunk& chunk : chunks) {
+        size_t base = static_cast<size_t>(chunk.key) << 16;
+        if (chunk.bitmap.empty()) {
+            for (uint16_t offset : chunk.array) out.push_back(base + offset);
+            continue;
+        }
+        for (size_t word = 0; word < bitmapWords; ++word) {
+            for (uint64_t bits = chunk.bitmap[word]; bits != 0; bits &= bits - 1) {
+                out.push_back(base + word * 64 + lowestBit(bits));
+            }
+        }
+    }
+}
+
+std::vector<size_t> PostingList::intersect(std::vector<const PostingList*> lists) {
+    std::vector<size_t> result;
+    if (lists.empty()) return result;
+    std::sort(lists.begin(), lists.end(), [](const PostingList* a, const PostingList* b) {
+        return a->size() < b->size();
+    });
+
+    std::vector<const Chunk*> matching(lists.size());
+    std::vector<uint64_t> words(bitmapWords);
+    for (const Chunk& first : lists.front()->chunks) {
+        // The same chunk in every list, sparsest first; a list without it empties the result
+        matching[0] = &first;
+        bool everywhere = true;
+        for (size_t i = 1; i < lists.size() && everywhere; ++i) {
+            auto chunk = lists[i]->findChunk(first.key);
+            everywhere = chunk != lists[i]->chunks.end() && chunk->key == first.key;
+            if (everywhere) matching[i] = &*chunk;
+        }
+        if (!everywhere) continue;
+        // Arrays first, then by count: a bitmap chunk may still be sparser than an array one,
+        // since it only turns back into an array well below the limit
+        std::sort(matching.begin(), matching.end(), [](const Chunk* a, const Chunk* b) {
+            if (a->bitmap.empty() != b->bitmap.empty()) return a->bitmap.empty();
+            return a->count < b->count;
+        });
+
+        size_t base = static_cast<size_t>(first.key) << 16;
+        if (matching[0]->bitmap.empty()) {
+            for (uint16_t offset : matching[0]->array) {
+                bool inAll = true;
+                for (size_t i = 1; i < matching.size() && inAll; ++i) inAll = chunkContains(*matching[i], offset);
+                if (inAll) result.push_back(base + offset);
+            }
+            continue;
+        }
+
+        // No array chunk, so every one is a bitmap
+        std::copy(matching[0]->bitmap.begin(), matching[0]->bitmap.end(), words.begin());
+        for (size_t i = 1; i < matching.size(); ++i) {
+            const uint64_t* other = matching[i]->bitmap.data();
+            for (size_t word = 0; word < bitmapWords; ++word) words[word] &= other[word];
+        }
+        for (size_t word = 0; word < bitmapWords; ++word) {
+            for (uint64_t bits = words[word]; bits != 0; bits &= bits - 1) {
+                result.push_back(base + word * 64 + lowestBit(bits));
+            }
+        }
+    }
+    return result;
+}
\ No newline at end of file
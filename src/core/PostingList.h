@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Ascending set of task positions, split into chunks of 65536 positions (the layout of
+// Roaring bitmaps). A chunk keeps its members as a sorted array of 16-bit offsets while it
+// has at most 4096 of them and as a bitmap beyond that, so inserting or erasing anywhere
+// touches at most 8 KiB, however long the list grows.
+class PostingList {
+public:
+    void insert(size_t position);
+    void erase(size_t position);
+    bool contains(size_t position) const;
+    size_t size() const;
+    bool empty() const;
+
+    // Appends every position, ascending
+    void appendTo(std::vector<size_t>& out) const;
+    // Positions present in every list, ascending. Works chunk by chunk: dense chunks are
+    // ANDed a word at a time, sparse ones probed offset by offset.
+    static std::vector<size_t> intersect(std::vector<const PostingList*> lists);
+
+private:
+    static constexpr size_t arrayLimit = 4096;  // beyond this a bitmap (8 KiB) is smaller
+    static constexpr size_t bitmapWords = 1024; // 65536 bits
+
+    struct Chunk {
+        uint32_t key = 0;             // position >> 16
+        uint32_t count = 0;
+        std::vector<uint16_t> array;  // sorted offsets while the chunk is sparse
+        std::vector<uint64_t> bitmap; // bitmapWords words once it is dense, empty otherwise
+    };
+
+    std::vector<Chunk>::iterator findChunk(uint32_t key);
+    std::vector<Chunk>::const_iterator findChunk(uint32_t key) const;
+    static bool chunkContains(const Chunk& chunk, uint16_t offset);
+    static void toBitmap(Chunk& chunk);
+    static void toArray(Chunk& chunk);
+
+    std::vector<Chunk> chunks; // ascending by key, none empty
+    size_t total = 0;
+};
\ No newline at end of file
@@ -0,0 +1,212 @@
+#include "QueryExecutor.h"
+#include "TaskManager.h"
+#include <algorithm>
+#include <iterator>
+
+// Index-aware planner and fused-scan executor for TaskQuery
+
+namespace {
+    // Number of elements in [first, last), but stops counting once it exceeds bound
+    template <typename It>
+    size_t boundedDistance(It first, It last, size_t bound) {
+        size_t count = 0;
+        for (; first != last && count <= bound; ++first) ++count;
+        return count;
+    }
+}
+
+QueryResult QueryExecutor::run(const TaskManager& manager, const TaskQuery& query) {
+    const TaskTable& tasks = manager.getAllTasks();
+    const DeadlineIndex& deadlines = manager.getDeadlineIndex();
+    const PriorityIndex& priorities = manager.getPriorityIndex();
+    const TagDictionary& dictionary = manager.getTagDictionary();
+    CommandParser parser;
+
+    auto nothing = [&](const std::string& reason) {
+        return QueryResult{ TaskView::of(tasks, {}), "empty (" + reason + ")" };
+    };
+
+    // Contradictory conditions need no work at all
+    if (query.minPriority > query.maxPriority) return nothing("priority range is empty");
+    if (query.dueFrom && query.dueBefore && *query.dueFrom >= *query.dueBefore) return nothing("deadline window is empty");
+
+    std::optional<TagId> tagId;
+    if (!query.tags.empty()) {
+        for (const auto& tag : query.tags) {
+            if (tag != query.tags.front()) return nothing("conflicting tags");
+        }
+        tagId = dictionary.find(query.tags.front());
+        if (!tagId) return nothing("unknown tag");
+    }
+    std::vector<TagId> excludedTagIds;
+    for (const auto& tag : query.excludedTags) {
+        if (auto id = dictionary.find(tag)) excludedTagIds.push_back(*id);
+    }
+
+    // Pick the smallest candidate source
+    enum class Source { Scan, Tag, Keyword, Deadline, Priority };
+    Source source = Source::Scan;
+    size_t best = tasks.size();
+    const std::vector<size_t>* candidates = nullptr;
+    std::vector<size_t> keywordCandidates;
+    std::vector<size_t> tagCandidates;
+
+    if (tagId) {
+        best = dictionary.countOf(*tagId);
+        source = Source::Tag;
+    }
+    for (const auto& keyword : query.keywords) {
+        auto found = manager.getKeywordIndex().candidates(keyword);
+        if (found && found->size() < best) {
+            keywordCandidates = std::move(*found);
+            candidates = &keywordCandidates;
+            best = keywordCandidates.size();
+            source = Source::Keyword;
+        }
+    }
+
+    const bool orderedByDeadline = query.orderBy == TaskQuery::OrderField::Deadline;
+    auto rangeBegin = query.dueFrom ? deadlines.lower_bound(*query.dueFrom) : deadlines.begin();
+    auto rangeEnd = query.dueBefore ? deadlines.lower_bound(*query.dueBefore) : deadlines.end();
+    if (query.dueFrom || query.dueBefore || orderedByDeadline) {
+        // Walking the deadline index also yields deadline order (and early exit with a limit) for free
+        size_t rangeSize = boundedDistance(rangeBegin, rangeEnd, best);
+        if (rangeSize < best || (source == Source::Scan && orderedByDeadline)) {
+            source = Source::Deadline;
+            best = rangeSize;
+        }
+    }
+
+    // Pending (or completed) tasks by descending priority are a run of the priority index
+    // already in the wanted order, e.g. for "not completed order by priority desc limit 10"
+    const bool orderedByPriority = query.orderBy == TaskQuery::OrderField::Priority && query.descending;
+    if (source == Source::Scan && orderedByPriority && query.completed) {
+        source = Source::Priority;
+    }
+
+    // Every condition, checked in one pass over the chosen candidates. The cheap column
+    // checks come first; titles and descriptions are only read for keyword conditions.
+    const TaskTable::Column<int64_t>& deadlineColumn = tasks.deadlineColumn();
+    const TaskTable::Column<uint8_t>& priorityColumn = tasks.priorityColumn();
+    const TaskTable::Column<TagId>& tagColumn = tasks.tagColumn();
+    const int64_t dueFrom = query.dueFrom ? TaskTable::toTicks(*query.dueFrom) : INT64_MIN;
+    const int64_t dueBefore = query.dueBefore ? TaskTable::toTicks(*query.dueBefore) : INT64_MAX;
+    auto matches = [&](size_t index) {
+        int priority = priorityColumn[index];
+        if (priority < query.minPriority || priority > query.maxPriority) return false;
+        if (query.completed && tasks.completed(index) != *query.completed) return false;
+
+        int64_t deadline = deadlineColumn[index];
+        if (deadline < dueFrom) return false;
+        if (query.dueBefore && deadline >= dueBefore) return false;
+
+        if (tagId || !excludedTagIds.empty()) {
+            TagId tag = tagColumn[index];
+            if (tagId && tag != *tagId) return false;
+            if (std::find(excludedTagIds.begin(), excludedTagIds.end(), tag) != excludedTagIds.end()) return false;
+        }
+
+        for (const auto& keyword : query.keywords) {
+            if (!parser.containsIgnoreCase(tasks.title(index), keyword) &&
+                !parser.containsIgnoreCase(tasks.description(index), keyword)) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    std::vector<size_t> rows;
+    bool alreadyOrdered = query.orderBy == TaskQuery::OrderField::None;
+    std::string plan;
+
+    if (source == Source::Deadline) {
+        alreadyOrdered = alreadyOrdered || orderedByDeadline;
+        const bool stopEarly = alreadyOrdered && query.limit.has_value();
+        auto visit = [&](size_t index) {
+            if (matches(index)) rows.push_back(index);
+            return !(stopEarly && rows.size() >= *query.limit);
+        };
+
+        if (orderedByDeadline && query.descending) {
+            for (auto it = std::make_reverse_iterator(rangeEnd); it != std::make_reverse_iterator(rangeBegin); ++it) {
+                if (!visit(it->second)) break;
+            }
+        }
+        else {
+            for (auto it = rangeBegin; it != rangeEnd; ++it) {
+                if (!visit(it->second)) break;
+            }
+        }
+        plan = "deadline index range";
+    }
+    else if (source == Source::Priority) {
+        alreadyOrdered = true;
+        const bool completed = *query.completed;
+        auto it = priorities.lower_bound(PriorityKey{ completed, static_cast<uint8_t>(query.maxPriority), INT64_MIN, 0 });
+        for (; it != priorities.end() && it->first.completed == completed && it->first.priority >= query.minPriority; ++it) {
+            if (matches(it->second)) rows.push_back(it->second);
+            if (query.limit && rows.size() >= *query.limit) break;
+        }
+        plan = "priority index";
+    }
+    else if (candidates || source == Source::Tag) {
+        if (source == Source::Tag) {
+            dictionary.tasksWith(*tagId).appendTo(tagCandidates);
+            candidates = &tagCandidates;
+        }
+        for (size_t index : *candidates) {
+            if (matches(index)) rows.push_back(index);
+        }
+        plan = source == Source::Tag ? "tag index" : "keyword index";
+    }
+    else {
+        for (size_t index = 0; index < tasks.size(); ++index) {
+            if (matches(index)) rows.push_back(index);
+        }
+        plan = "full scan";
+    }
+    plan += " (" + std::to_string(best) + " candidates)";
+
+    if (!alreadyOrdered) {
+        // Ties are broken by list position so results are deterministic
+        auto less = [&](size_t a, size_t b) {
+            switch (query.orderBy) {
+            case TaskQuery::OrderField::Deadline: {
+                int64_t x = deadlineColumn[a], y = deadlineColumn[b];
+                if (x != y) return query.descending ? x > y : x < y;
+                break;
+            }
+            case TaskQuery::OrderField::Priority: {
+                // Equal priorities go soonest deadline first, then by id, as in the priority index
+                uint8_t x = priorityColumn[a], y = priorityColumn[b];
+                if (x != y) return query.descending ? x > y : x < y;
+                if (deadlineColumn[a] != deadlineColumn[b]) return deadlineColumn[a] < deadlineColumn[b];
+                return tasks.id(a) < tasks.id(b);
+            }
+            case TaskQuery::OrderField::Title: {
+                int cmp = tasks.title(a).compare(tasks.title(b));
+                if (cmp != 0) return query.descending ? cmp > 0 : cmp < 0;
+                break;
+            }
+            case TaskQuery::OrderField::None:
+                break;
+            }
+            return a < b;
+        };
+
+        if (query.limit && *query.limit < rows.size()) {
+            std::partial_sort(rows.begin(), rows.begin() + *query.limit, rows.end(), less);
+            plan += ", top-" + std::to_string(*query.limit) + " partial sort";
+        }
+        else {
+            std::sort(rows.begin(), rows.end(), less);
+            plan += ", sorted";
+        }
+    }
+    else if ((source == Source::Deadline || source == Source::Priority) && query.limit) {
+        plan += ", early exit at limit";
+    }
+
+    if (query.limit && rows.size() > *query.limit) rows.resize(*query.limit);
+    return QueryResult{ TaskView::of(tasks, std::move(rows)), plan };
+}
\ No newline at end of file
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "TaskQuery.h"
+#include "TaskView.h"
+#include <string>
+
+class TaskManager;
+
+struct QueryResult {
+    TaskView rows;
+    std::string plan; // how the query was answered, e.g. "tag index (12 candidates)"
+};
+
+// Runs a TaskQuery against a TaskManager. The most selective available index
+// (tag posting list, keyword trigrams, deadline range) drives the query; every
+// other condition is checked in a single fused pass over its candidates.
+class QueryExecutor {
+public:
+    static QueryResult run(const TaskManager& manager, const TaskQuery& query);
+};
\ No newline at end of file
@@ -0,0 +1,129 @@
+#include "SlotMap.h"
+#include <algorithm>
+#include <stdexcept>
+
+// Id -> position indirection with per-slot generations
+
+TaskId SlotMap::makeId(uint32_t slot, uint32_t generation) {
+    return (static_cast<TaskId>(generation) << 32) | (static_cast<TaskId>(slot) + 1);
+}
+
+const SlotMap::Slot* SlotMap::slotOf(TaskId id) const {
+    uint32_t low = static_cast<uint32_t>(id);
+    if (low == 0 || low > slots.size()) return nullptr;
+    const Slot& slot = slots[low - 1];
+    if (slot.position == freeSlot || slot.generation != static_cast<uint32_t>(id >> 32)) return nullptr;
+    return &slot;
+}
+
+TaskId SlotMap::insert(size_t position) {
+    if (position >= freeSlot) throw std::length_error("Too many tasks");
+
+    while (freeSlots.size() > minimumFreeSlots) {
+        uint32_t index = freeSlots.front();
+        freeSlots.pop_front();
+        Slot& slot = slots[index];
+        if (slot.position != freeSlot) continue; // restored since it was freed
+        slot.position = static_cast<uint32_t>(position);
+        ++live;
+        return makeId(index, slot.generation);
+    }
+
+    if (slots.size() >= freeSlot - 1) throw std::length_error("Too many tasks");
+    slots.push_back(Slot{ 0, static_cast<uint32_t>(position) });
+    ++live;
+    return makeId(static_cast<uint32_t>(slots.size() - 1), 0);
+}
+
+bool SlotMap::restore(TaskId id, size_t position) {
+    uint32_t low = static_cast<uint32_t>(id);
+    if (low == 0 || low == freeSlot || position >= freeSlot) return false;
+
+    uint32_t index = low - 1;
+    // An id far past anything this list could have issued is corrupt; refusing it (the caller
+    // then assigns a fresh one) avoids allocating a huge run of empty slots
+    if (index - std::min<size_t>(index, slots.size() + position) > maximumRestoreGap) return false;
+    while (slots.size() <= index) {
+        // A gap most likely held a task deleted before the save. Starting past generation 0
+        // keeps a freshly loaded list from handing that task's id out again.
+        freeSlots.push_back(static_cast<uint32_t>(slots.size()));
+        slots.push_back(Slot{ 1, freeSlot });
+    }
+
+    Slot& slot = slots[index];
+    if (slot.position != freeSlot) return false;
+    slot.generation = static_cast<uint32_t>(id >> 32);
+    slot.position = static_cast<uint32_t>(position);
+    ++live;
+    return true;
+}
+
+void SlotMap::restoreFree(const SlotMapState& state) {
+    // Bounded like restore(), so a corrupt count cannot allocate billions of slots
+    if (state.slotCount > slots.size() && state.slotCount - slots.size() <= maximumRestoreGap + state.freeIds.size()) {
+        slots.resize(state.slotCount);
+    }
+
+    std::vector<bool> reusable(slots.size());
+    freeSlots.clear();
+    for (TaskId id : state.freeIds) {
+        uint32_t low = static_cast<uint32_t>(id);
+        if (low == 0 || low > slots.size() || reusable[low - 1] || slots[low - 1].position != freeSlot) continue;
+        reusable[low - 1] = true;
+        slots[low - 1].generation = static_cast<uint32_t>(id >> 32);
+        freeSlots.push_back(low - 1);
+    }
+    for (size_t index = 0; index < slots.size(); ++index) {
+        if (slots[index].position == freeSlot && !reusable[index]) slots[index].generation = UINT32_MAX; // never handed out again
+    }
+}
+
+// Free slots in reuse order, without the queue's stale or repeated entries
+SlotMapState SlotMap::state() const {
+    SlotMapState result;
+    result.slotCount = static_cast<uint32_t>(slots.size());
+    std::vector<bool> listed(slots.size());
+    for (uint32_t index : freeSlots) {
+        if (slots[index].position != freeSlot || listed[index]) continue;
+        listed[index] = true;
+        result.freeIds.push_back(makeId(index, slots[index].generation));
+    }
+    return result;
+}
+
+void SlotMap::erase(TaskId id) {
+    if (!slotOf(id)) throw std::out_of_range("Unknown task id");
+    uint32_t index = static_cast<uint32_t>(id) - 1;
+    Slot& slot = slots[index];
+    slot.position = freeSlot;
+    --live;
+    // A slot whose generation would wrap around is retired instead of risking an old id
+    if (slot.generation == UINT32_MAX) return;
+    ++slot.generation;
+    freeSlots.push_back(index);
+}
+
+void SlotMap::relocate(TaskId id, size_t position) {
+    if (!slotOf(id)) throw std::out_of_range("Unknown task id");
+    slots[static_cast<uint32_t>(id) - 1].position = static_cast<uint32_t>(position);
+}
+
+void SlotMap::clear() {
+    slots.clear();
+    freeSlots.clear();
+    live = 0;
+}
+
+std::optional<size_t> SlotMap::find(TaskId id) const {
+    const Slot* slot = slotOf(id);
+    if (!slot) return std::nullopt;
+    return slot->position;
+}
+
+bool SlotMap::contains(TaskId id) const {
+    return slotOf(id) != nullptr;
+}
+
+size_t SlotMap::size() const {
+    return live;
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Task.h"
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <vector>
+
+// The allocator state of a SlotMap beyond its live ids. It is saved with the tasks, so a
+// restarted process never hands out the id of a task that was deleted before the save.
+struct SlotMapState {
+    uint32_t slotCount = 0;
+    std::vector<TaskId> freeIds; // the id each reusable slot hands out next, in reuse order
+};
+
+// Generational slot map from stable task ids to positions in the task list.
+// An id packs a slot number (low 32 bits, 1-based so 0 stays "no id") and the slot's
+// generation (high 32 bits). Freeing a slot bumps its generation, so ids of deleted tasks
+// never resolve again. Insert, erase, relocate and lookup are all O(1).
+class SlotMap {
+public:
+    // Registers a task at position under a fresh id
+    TaskId insert(size_t position);
+    // Registers a task under the id it was saved with; false if the id is malformed or taken
+    bool restore(TaskId id, size_t position);
+    // After the saved ids were restored: brings back the slots no task holds as they were saved.
+    // Slots the state does not list as free (or that it predates) are retired.
+    void restoreFree(const SlotMapState& state);
+    SlotMapState state() const;
+    // Forgets the id; it must be present
+    void erase(TaskId id);
+    // Records that the task with this id now lives at position
+    void relocate(TaskId id, size_t position);
+    void clear();
+
+    std::optional<size_t> find(TaskId id) const;
+    bool contains(TaskId id) const;
+    size_t size() const;
+
+private:
+    static constexpr uint32_t freeSlot = UINT32_MAX;
+    // Freed slots are reused first-in first-out, and only once this many are waiting, so a
+    // slot's generation grows slowly and a just-deleted id is not handed out again right away
+    static constexpr size_t minimumFreeSlots = 1024;
+    static constexpr size_t maximumRestoreGap = 1 << 24;
+
+    struct Slot {
+        uint32_t generation = 0;
+        uint32_t position = freeSlot;
+    };
+
+    static TaskId makeId(uint32_t slot, uint32_t generation);
+    const Slot* slotOf(TaskId id) const;
+
+    std::vector<Slot> slots;
+    std::deque<uint32_t> freeSlots; // may hold slots restore() has taken since; insert skips those
+    size_t live = 0;
+};
\ No newline at end of file
@@ -0,0 +1,83 @@
+#include "StringArena.h"
+#include <algorithm>
+#include <cstring>
+
+// Bump allocator for the task strings
+
+namespace {
+    // Chunks double from 64 KiB up to 64 MiB, so a million tasks' text takes about a dozen
+    constexpr size_t firstChunkSize = size_t(64) << 10;
+    constexpr size_t maxChunkSize = size_t(64) << 20;
+}
+
+// The copy shares every chunk but leaves the free tail of the last one to the original
+StringArena::StringArena(const StringArena& other)
+    : chunks(other.chunks), used(other.used), lastChunkSize(other.lastChunkSize) {
+}
+
+StringArena& StringArena::operator=(const StringArena& other) {
+    if (this != &other) {
+        chunks = other.chunks;
+        next = end = nullptr;
+        used = other.used;
+        lastChunkSize = other.lastChunkSize;
+    }
+    return *this;
+}
+
+StringArena::StringArena(StringArena&& other) noexcept
+    : chunks(std::move(other.chunks)), next(other.next), end(other.end), used(other.used), lastChunkSize(other.lastChunkSize) {
+    other.clear();
+}
+
+StringArena& StringArena::operator=(StringArena&& other) noexcept {
+    if (this != &other) {
+        chunks = std::move(other.chunks);
+        next = other.next;
+        end = other.end;
+        used = other.used;
+        lastChunkSize = other.lastChunkSize;
+        other.clear();
+    }
+    return *this;
+}
+
+std::string_view StringArena::append(std::string_view text) {
+    if (text.empty()) return std::string_view();
+    if (static_cast<size_t>(end - next) < text.size()) {
+        addChunk(std::max(text.size(), std::min(lastChunkSize * 2, maxChunkSize)));
+    }
+    char* copy = next;
+    std::memcpy(copy, text.data(), text.size());
+    next += text.size();
+    used += text.size();
+    return std::string_view(copy, text.size());
+}
+
+void StringArena::reserve(size_t bytes) {
+    if (static_cast<size_t>(end - next) < bytes) addChunk(bytes);
+}
+
+void StringArena::clear() {
+    chunks.clear();
+    next = end = nullptr;
+    used = 0;
+    lastChunkSize = 0;
+}
+
+size_t StringArena::usedBytes() const {
+    return used;
+}
+
+size_t StringArena::chunkCount() const {
+    return chunks.size();
+}
+
+// Whatever was left free in the previous chunk is abandoned
+void StringArena::addChunk(size_t capacity) {
+    capacity = std::max(capacity, firstChunkSize);
+    chunks.emplace_back(new char[capacity]);
+    next = chunks.back().get();
+    end = next + capacity;
+    lastChunkSize = capacity;
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+// Append-only store for the bytes of many small strings, packed into a few large chunks.
+// Bytes are never moved or overwritten once written, so the views append() returns stay
+// valid as long as any arena holding their chunk does. Copying an arena shares the chunks
+// instead of copying them; each copy then writes new strings into chunks of its own.
+class StringArena {
+public:
+    StringArena() = default;
+    StringArena(const StringArena& other);
+    StringArena& operator=(const StringArena& other);
+    StringArena(StringArena&& other) noexcept;
+    StringArena& operator=(StringArena&& other) noexcept;
+
+    // Copies text into the arena and returns a view of the copy
+    std::string_view append(std::string_view text);
+    // Makes room for at least `bytes` more without another allocation (e.g. before a bulk load)
+    void reserve(size_t bytes);
+    void clear();
+
+    size_t usedBytes() const;  // every string appended so far, whether still referenced or not
+    size_t chunkCount() const;
+
+private:
+    void addChunk(size_t capacity);
+
+    std::vector<std::shared_ptr<char[]>> chunks;
+    char* next = nullptr;  // free space at the end of the last chunk, which only this arena writes
+    char* end = nullptr;
+    size_t used = 0;
+    size_t lastChunkSize = 0;
+};
\ No newline at end of file
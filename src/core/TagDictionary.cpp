@@ -0,0 +1,70 @@
+#include "TagDictionary.h"
+#include <algorithm>
+#include <cctype>
+
+// Dictionary of interned tags with per-tag posting lists
+
+// Returns the id of the case-folded tag, creating a new entry if needed
+TagId TagDictionary::intern(std::string_view tag) {
+    std::string folded(tag);
+    std::transform(folded.begin(), folded.end(), folded.begin(),
+        [](unsigned char c) { return std::tolower(c); });
+
+    auto found = ids.find(folded);
+    if (found != ids.end()) return found->second;
+
+    TagId id = static_cast<TagId>(names.size());
+    ids.emplace(folded, id);
+    names.push_back(std::move(folded));
+    postings.emplace_back();
+    return id;
+}
+
+std::optional<TagId> TagDictionary::find(const std::string& loweredTag) const {
+    auto found = ids.find(loweredTag);
+    if (found == ids.end()) return std::nullopt;
+    return found->second;
+}
+
+const std::string& TagDictionary::name(TagId id) const {
+    return names.at(id);
+}
+
+size_t TagDictionary::size() const {
+    return names.size();
+}
+
+// Records the tag of the task at index (either a new task or one being re-indexed after an edit)
+// and returns its id
+TagId TagDictionary::add(size_t index, std::string_view tag) {
+    TagId id = intern(tag);
+    postings[id].insert(index);
+    return id;
+}
+
+// Drops the task at index from the posting list of its tag id
+void TagDictionary::remove(size_t index, TagId id) {
+    postings[id].erase(index);
+}
+
+// After the task at index was removed, the last task (at last, tagged lastTag) takes its place.
+// Only the moved task's posting entry changes; call it only when index is not the last one.
+void TagDictionary::moveLastTo(size_t index, size_t last, TagId lastTag) {
+    postings[lastTag].erase(last);
+    postings[lastTag].insert(index);
+}
+
+// Drops all tasks and tags
+void TagDictionary::clear() {
+    ids.clear();
+    names.clear();
+    postings.clear();
+}
+
+const PostingList& TagDictionary::tasksWith(TagId id) const {
+    return postings.at(id);
+}
+
+size_t TagDictionary::countOf(TagId id) const {
+    return postings.at(id).size();
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "PostingList.h"
+
+using TagId = uint32_t;
+
+// Interns case-folded tags into small integer ids and keeps, per tag,
+// the ascending set of task indices carrying it. The id of each task's tag
+// is kept in TaskTable's tag column, so updates take it from the caller.
+// The sets are PostingLists, so an update touches one chunk of at most 8 KiB
+// however many tasks share the tag.
+class TagDictionary {
+public:
+    TagId intern(std::string_view tag);
+    std::optional<TagId> find(const std::string& loweredTag) const;
+    const std::string& name(TagId id) const;
+    size_t size() const;
+
+    TagId add(size_t index, std::string_view tag);
+    void remove(size_t index, TagId id);
+    void moveLastTo(size_t index, size_t last, TagId lastTag);
+    void clear();
+
+    const PostingList& tasksWith(TagId id) const;
+    size_t countOf(TagId id) const;
+
+private:
+    std::unordered_map<std::string, TagId> ids;
+    std::vector<std::string> names;
+    std::vector<PostingList> postings;
+};
\ No newline at end of file
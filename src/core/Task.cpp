@@ -1,25 +1,23 @@
 ﻿#include "Task.h"
-#include <iostream>
-#include <iomanip>
-#include <ctime>
 #include "DateTimeUtils.h"
+#include "TaskRenderer.h"
 
 using json = nlohmann::json;
 
 // Represents a task with title, description, deadline, priority, tag, and completion status
 
-Task::Task(const std::string& title,
-    const std::string& description,
+Task::Task(std::string title,
+    std::string description,
     const std::chrono::system_clock::time_point& deadline,
     Priority priority,
-    const std::string& tag,
+    std::string tag,
     bool status)
-    : title_(title), description_(description), deadline_(deadline),
-    priority_(priority), tag_(tag), completed_(status){
+    : title_(std::move(title)), description_(std::move(description)), deadline_(deadline),
+    priority_(priority), tag_(std::move(tag)), completed_(status){
 }
 
 // Accessors and mutators
-std::string Task::getTitle() const {
+const std::string& Task::getTitle() const {
     return title_;
 }
 
@@ -27,7 +25,7 @@ void Task::setTitle(std::string titl) {
     title_ = titl;
 }
 
-std::string Task::getDescription() const {
+const std::string& Task::getDescription() const {
     return description_;
 }
 
@@ -43,7 +41,7 @@ Priority Task::getPriority() const {
     return priority_;
 }
 
-std::string Task::getTag() const {
+const std::string& Task::getTag() const {
     return tag_;
 }
 
@@ -55,32 +53,21 @@ void Task::setCompleted(bool status_) {
     completed_ = status_;
 }
 
+TaskId Task::getId() const {
+    return id_;
+}
+
+void Task::setId(TaskId id) {
+    id_ = id;
+}
+
 // Prints task details to the console
 void Task::print() const {
-    std::time_t deadline_time = std::chrono::system_clock::to_time_t(deadline_);
-    std::tm* tm_ptr = std::localtime(&deadline_time);
-    // Adjust for DST if needed
-    if (tm_ptr->tm_isdst > 0) {
-        deadline_time -= 3600;
-        tm_ptr = std::localtime(&deadline_time);
-    }
-
-    std::cout << (completed_ ? "[+] " : "[ ] ");
-    std::cout << "Title: " << title_ << '\n'
-        << "Description: " << description_ << '\n'
-        << "Deadline: " << std::put_time(tm_ptr, "%Y-%m-%d %H:%M") << '\n'
-        << "Priority: ";
-
-    switch (priority_) {
-    case Priority::Low: std::cout << "Low"; break;
-    case Priority::Medium: std::cout << "Medium"; break;
-    case Priority::High: std::cout << "High"; break;
-    }
-
-    std::cout << '\n' << "Tag: " << tag_ << "\n\n";
+    TaskRenderer renderer;
+    renderer.add(*this);
 }
 
-// Serialize Task to JSON
+// Serialize Task to JSON (the id only once the task has one)
 void to_json(json& j, const Task& task) {
     j = json{
         {"title", task.title_},
@@ -90,14 +77,19 @@ void to_json(json& j, const Task& task) {
         {"tag", task.tag_},
         {"completed", task.completed_}
     };
+    if (task.id_ != 0) j["id"] = task.id_;
 }
 
 // Deserialize JSON to Task
 void from_json(const json& j, Task& task) {
     task.title_ = j.at("title").get<std::string>();
     task.description_ = j.at("description").get<std::string>();
-    task.deadline_ = DateTimeUtils::stringToTimePoint(j.at("deadline").get<std::string>());
+    const json& deadline = j.at("deadline");
+    task.deadline_ = deadline.is_number_integer()
+        ? DateTimeUtils::fromEpochSeconds(deadline.get<int64_t>())
+        : DateTimeUtils::stringToTimePoint(deadline.get<std::string>());
     task.priority_ = static_cast<Priority>(j.at("priority").get<int>());
     task.tag_ = j.at("tag").get<std::string>();
     task.completed_ = j.at("completed").get<bool>();
+    task.id_ = j.value("id", TaskId(0)); // files written before tasks had ids get them on load
 }
\ No newline at end of file
@@ -2,30 +2,36 @@
 
 #include <string>
 #include <chrono>
+#include <cstdint>
 #include "enums.h"
 #include <nlohmann/json.hpp>
 
+// Stable task identifier handed out by the TaskManager; 0 means "not assigned yet"
+using TaskId = uint64_t;
+
 class Task {
 public:
     Task() = default;
-    Task(const std::string& title,
-        const std::string& description,
+    Task(std::string title,
+        std::string description,
         const std::chrono::system_clock::time_point& deadline,
         Priority priority,
-        const std::string& tag = "",
+        std::string tag = "",
         bool status = false);
 
 
     // 
-    std::string getTitle() const;
+    const std::string& getTitle() const;
     void setTitle(std::string titl);
-    std::string getDescription() const;
+    const std::string& getDescription() const;
     std::chrono::system_clock::time_point getDeadline() const;
     void setDeadline(std::chrono::system_clock::time_point& deadline);
     Priority getPriority() const;
-    std::string getTag() const;
+    const std::string& getTag() const;
     bool getCompleted() const;
     void setCompleted(bool status);
+    TaskId getId() const;
+    void setId(TaskId id);
 
     //    / 
     void print() const;
@@ -40,4 +46,5 @@ private:
     Priority priority_;
     std::string tag_;
     bool completed_ = false;
+    TaskId id_ = 0;
 };
\ No newline at end of file
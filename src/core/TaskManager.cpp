@@ -1,121 +1,457 @@
 #include "TaskManager.h"
-#include <iostream>;
+#include "TaskRenderer.h"
+#include <iostream>
 #include <chrono>
+#include <stdexcept>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
 
 // Manages a collection of tasks: CRUD operations, filtering, and storage
 
-void TaskManager::addTask(const Task& task) {
-    tasks.push_back(task);
+template <typename Row>
+static SearchText searchTextOf(const Row& task) {
+    return SearchText{ task.getTitle(), task.getDescription() };
 }
 
-// Removes a task by index; returns false if index is invalid
-bool TaskManager::removeTask(size_t index) {
-    if (index >= tasks.size()) return false;
-    tasks.erase(tasks.begin() + index);
+// Appends a task under a fresh id and returns it
+TaskId TaskManager::addTask(const Task& task) {
+    return insertTask(task, false);
+}
+
+// Appends a task under a fresh id, or (when replaying the journal) under the id it was logged with
+TaskId TaskManager::insertTask(const Task& task, bool keepId) {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    size_t index = tasks.size();
+    TaskId id = task.getId();
+    if (!keepId || !ids.restore(id, index)) id = ids.insert(index);
+    Task stored = task;
+    stored.setId(id);
+    journal.recordAdd(stored);
+    tasks.push_back(std::move(stored));
+    indexTask(index);
+    generation++;
+    notifyMutation();
+    return id;
+}
+
+// Removes a task without shifting the list: the last task moves into its place, so only the
+// removed and the moved task's index entries change. That costs O(log n) in the ordered
+// deadline and priority indexes; the id lookup is O(1) and each tag posting update touches
+// one chunk of at most 8 KiB. Returns false if there is no task with this id.
+bool TaskManager::removeTask(TaskId id) {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    auto found = ids.find(id);
+    if (!found) return false;
+    size_t index = *found;
+    size_t last = tasks.size() - 1;
+    deadlineIndex.erase(deadlineEntry(index));
+    priorityIndex.erase(priorityEntry(index));
+    tagDictionary.remove(index, tasks.tagColumn()[index]);
+
+    if (index != last) {
+        deadlineEntry(last)->second = index;
+        priorityEntry(last)->second = index;
+        if (keywordIndexReady) keywordIndex.replace(index, searchTextOf(tasks[index]), last, searchTextOf(tasks[last]));
+        tagDictionary.moveLastTo(index, last, tasks.tagColumn()[last]);
+        ids.relocate(tasks.id(last), index);
+    }
+    else if (keywordIndexReady) {
+        keywordIndex.remove(index, searchTextOf(tasks[index]));
+    }
+    tasks.moveLastTo(index);
+    ids.erase(id);
+
+    journal.recordRemove(id);
+    generation++;
+    notifyMutation();
+    return true;
+}
+
+// Replaces the task with the given id, which keeps its id; returns false if there is none
+bool TaskManager::editTask(TaskId id, const Task& newTask) {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    auto found = ids.find(id);
+    if (!found) return false;
+    size_t index = *found;
+    deadlineIndex.erase(deadlineEntry(index));
+    priorityIndex.erase(priorityEntry(index));
+    tagDictionary.remove(index, tasks.tagColumn()[index]);
+    if (keywordIndexReady) keywordIndex.update(index, searchTextOf(tasks[index]), searchTextOf(newTask));
+
+    Task stored = newTask;
+    stored.setId(id);
+    journal.recordEdit(id, stored);
+    tasks.assign(index, std::move(stored));
+    deadlineIndex.emplace(tasks.deadline(index), index);
+    priorityIndex.emplace(priorityKeyOf(index), index);
+    tasks.setTagId(index, tagDictionary.add(index, tasks.tag(index)));
+    generation++;
+    notifyMutation();
     return true;
 }
 
-// Replaces a task at given index with a new one; returns false if index is invalid
-bool TaskManager::editTask(size_t index, const Task& newTask) {
-    if (index >= tasks.size()) return false;
-    tasks[index] = newTask;
+// Marks a task as completed or not; returns false if there is no task with this id
+bool TaskManager::setCompleted(TaskId id, bool completed) {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    auto found = ids.find(id);
+    if (!found) return false;
+    if (tasks.completed(*found) != completed) {
+        // Completion moves the task between the pending and completed parts of the priority
+        // index; the node is re-keyed in place rather than reallocated
+        auto node = priorityIndex.extract(priorityEntry(*found));
+        node.key().completed = completed;
+        priorityIndex.insert(std::move(node));
+        tasks.setCompleted(*found, completed);
+    }
+    journal.recordCompleted(id, completed);
+    generation++;
+    notifyMutation();
     return true;
 }
 
-const std::vector<Task>& TaskManager::getAllTasks() const {
+const TaskTable& TaskManager::getAllTasks() const {
     return tasks;
 }
 
+// Deadline-ordered view of task indices (soonest first), maintained on every mutation
+const DeadlineIndex& TaskManager::getDeadlineIndex() const {
+    return deadlineIndex;
+}
+
+// Composite order (pending first, then priority, deadline and id), maintained on every mutation
+const PriorityIndex& TaskManager::getPriorityIndex() const {
+    return priorityIndex;
+}
+
+void TaskManager::indexTask(size_t index) {
+    deadlineIndex.emplace(tasks.deadline(index), index);
+    priorityIndex.emplace(priorityKeyOf(index), index);
+    if (keywordIndexReady) keywordIndex.add(index, searchTextOf(tasks[index]));
+    tasks.setTagId(index, tagDictionary.add(index, tasks.tag(index)));
+}
+
+// The deadline index entry of the task at index (every task has exactly one)
+DeadlineIndex::iterator TaskManager::deadlineEntry(size_t index) {
+    auto range = deadlineIndex.equal_range(tasks.deadline(index));
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == index) return it;
+    }
+    throw std::logic_error("Deadline index is out of sync");
+}
+
+static PriorityKey priorityKeyIn(const TaskTable& tasks, size_t index) {
+    return PriorityKey{ tasks.completed(index), tasks.priorityColumn()[index], tasks.deadlineColumn()[index], tasks.id(index) };
+}
+
+PriorityKey TaskManager::priorityKeyOf(size_t index) const {
+    return priorityKeyIn(tasks, index);
+}
+
+// The priority index entry of the task at index; its key is unique, so this is one lookup
+PriorityIndex::iterator TaskManager::priorityEntry(size_t index) {
+    auto found = priorityIndex.find(priorityKeyOf(index));
+    if (found == priorityIndex.end() || found->second != index) throw std::logic_error("Priority index is out of sync");
+    return found;
+}
+
+// Rebuilds all secondary indexes from scratch (used after bulk loads), in the index orders
+// the file was saved with if it has them; the keyword index waits for its first lookup
+void TaskManager::rebuildIndexes(const TaskFileExtras& saved) {
+    deadlineIndex.clear();
+    priorityIndex.clear();
+    keywordIndex.clear();
+    keywordIndexReady = false;
+    tagDictionary.clear();
+    indexTasksFrom(0, &saved);
+}
+
+// A saved order is only trusted if it lists every row once and in index order; a damaged
+// or stale one is sorted again instead
+template <typename Less>
+static bool isIndexOrder(const std::vector<uint32_t>& order, size_t count, Less less) {
+    if (order.size() != count) return false;
+    std::vector<bool> seen(count);
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t row = order[i];
+        if (row >= count || seen[row] || (i > 0 && less(row, order[i - 1]))) return false;
+        seen[row] = true;
+    }
+    return true;
+}
+
+// Indexes tasks[first..]. Into an empty deadline or priority index the entries are inserted
+// pre-sorted at the end, which the map does in constant time each; a full rebuild takes the
+// sorted orders from `saved` when they check out, and sorts otherwise.
+void TaskManager::indexTasksFrom(size_t first, const TaskFileExtras* saved) {
+    const auto& deadlines = tasks.deadlineColumn();
+    if (first == 0 && saved && isIndexOrder(saved->deadlineOrder, tasks.size(),
+            [&deadlines](uint32_t a, uint32_t b) { return deadlines[a] < deadlines[b]; })) {
+        for (uint32_t row : saved->deadlineOrder) {
+            deadlineIndex.emplace_hint(deadlineIndex.end(), tasks.deadline(row), row);
+        }
+    }
+    else if (deadlineIndex.empty()) {
+        std::vector<std::pair<std::chrono::system_clock::time_point, size_t>> order;
+        order.reserve(tasks.size() - first);
+        for (size_t i = first; i < tasks.size(); ++i) {
+            order.emplace_back(tasks.deadline(i), i);
+        }
+        std::sort(order.begin(), order.end()); // equal deadlines stay in list order, as emplace keeps them
+        for (const auto& entry : order) {
+            deadlineIndex.emplace_hint(deadlineIndex.end(), entry.first, entry.second);
+        }
+    }
+    else {
+        for (size_t i = first; i < tasks.size(); ++i) {
+            deadlineIndex.emplace(tasks.deadline(i), i);
+        }
+    }
+
+    bool prioritiesRestored = false;
+    if (first == 0 && saved && saved->priorityOrder.size() == tasks.size()) {
+        // Keys are gathered in row order first, since the saved order visits the rows at random
+        std::vector<PriorityKey> keys;
+        keys.reserve(tasks.size());
+        for (size_t i = 0; i < tasks.size(); ++i) keys.push_back(priorityKeyOf(i));
+        const auto& order = saved->priorityOrder;
+        if (isIndexOrder(order, keys.size(), [&keys](uint32_t a, uint32_t b) { return keys[a] < keys[b]; })) {
+            for (uint32_t row : order) {
+                priorityIndex.emplace_hint(priorityIndex.end(), keys[row], row);
+            }
+            prioritiesRestored = true;
+        }
+    }
+    if (!prioritiesRestored && priorityIndex.empty()) {
+        std::vector<std::pair<PriorityKey, size_t>> order;
+        order.reserve(tasks.size() - first);
+        for (size_t i = first; i < tasks.size(); ++i) {
+            order.emplace_back(priorityKeyOf(i), i);
+        }
+        std::sort(order.begin(), order.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+        for (const auto& entry : order) {
+            priorityIndex.emplace_hint(priorityIndex.end(), entry.first, entry.second);
+        }
+    }
+    else if (!prioritiesRestored) {
+        for (size_t i = first; i < tasks.size(); ++i) {
+            priorityIndex.emplace(priorityKeyOf(i), i);
+        }
+    }
+
+    for (size_t i = first; i < tasks.size(); ++i) {
+        if (keywordIndexReady) keywordIndex.add(i, searchTextOf(tasks[i]));
+        tasks.setTagId(i, tagDictionary.add(i, tasks.tag(i)));
+    }
+}
+
+// The index orders as they stand, for a backend that saves them
+void TaskManager::saveIndexOrders(TaskFileExtras& extras) const {
+    extras.deadlineOrder.clear();
+    extras.deadlineOrder.reserve(deadlineIndex.size());
+    for (const auto& entry : deadlineIndex) extras.deadlineOrder.push_back(static_cast<uint32_t>(entry.second));
+    extras.priorityOrder.clear();
+    extras.priorityOrder.reserve(priorityIndex.size());
+    for (const auto& entry : priorityIndex) extras.priorityOrder.push_back(static_cast<uint32_t>(entry.second));
+}
+
+// The same orders for a compaction snapshot, which the live indexes have moved on from,
+// sorted from its own columns on the writing thread
+static void sortIndexOrders(const TaskTable& tasks, TaskFileExtras& extras) {
+    const auto& deadlines = tasks.deadlineColumn();
+    extras.deadlineOrder.resize(tasks.size());
+    std::iota(extras.deadlineOrder.begin(), extras.deadlineOrder.end(), 0);
+    std::stable_sort(extras.deadlineOrder.begin(), extras.deadlineOrder.end(),
+        [&deadlines](uint32_t a, uint32_t b) { return deadlines[a] < deadlines[b]; });
+
+    extras.priorityOrder.resize(tasks.size());
+    std::iota(extras.priorityOrder.begin(), extras.priorityOrder.end(), 0);
+    std::sort(extras.priorityOrder.begin(), extras.priorityOrder.end(),
+        [&tasks](uint32_t a, uint32_t b) { return priorityKeyIn(tasks, a) < priorityKeyIn(tasks, b); });
+}
+
+// Moves a batch onto the list; every column grows geometrically on its own
+void TaskManager::appendTasks(std::vector<Task>&& batch) {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    if (!appendStart) appendStart = tasks.size();
+    for (auto& task : batch) {
+        task.setId(ids.insert(tasks.size())); // imported tasks are new, whatever ids they carried
+        tasks.push_back(std::move(task));
+    }
+}
+
+void TaskManager::finishAppend() {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    if (!appendStart) return;
+    if (*appendStart < tasks.size()) {
+        indexTasksFrom(*appendStart);
+        compactionPending = true; // the appended tasks only reach disk with the next snapshot
+        generation++;
+        notifyMutation();
+    }
+    appendStart.reset();
+}
+
 
 // Returns tasks sorted by deadline (soonest first)
-std::vector<Task> TaskManager::getTasksSortedByDeadline() const {
-    std::vector<Task> sorted = tasks;
-    std::sort(sorted.begin(), sorted.end(), [](const Task& a, const Task& b) {
-        return a.getDeadline() < b.getDeadline();
-        });
-    return sorted;
+TaskView TaskManager::getTasksSortedByDeadline() const {
+    std::vector<size_t> sorted;
+    sorted.reserve(tasks.size());
+    for (const auto& entry : deadlineIndex) {
+        sorted.push_back(entry.second);
+    }
+    return TaskView::of(tasks, std::move(sorted));
 }
 
-// Returns tasks sorted by priority (high to low)
-std::vector<Task> TaskManager::getTasksSortedByPriority() const {
-    std::vector<Task> sorted = tasks;
-    std::sort(sorted.begin(), sorted.end(), [](const Task& a, const Task& b) {
-        return static_cast<int>(a.getPriority()) > static_cast<int>(b.getPriority());
-        });
-    return sorted;
+// Returns tasks sorted by priority (high to low), then deadline (soonest first), then id.
+// The priority index holds the pending and the completed tasks as two runs in that order,
+// so one merge of the runs yields the listing without sorting.
+TaskView TaskManager::getTasksSortedByPriority() const {
+    auto completedBegin = priorityIndex.lower_bound(PriorityKey{ true, UINT8_MAX, INT64_MIN, 0 });
+    auto before = [](const PriorityKey& a, const PriorityKey& b) {
+        return PriorityKey{ false, a.priority, a.deadline, a.id } < PriorityKey{ false, b.priority, b.deadline, b.id };
+    };
+
+    std::vector<size_t> sorted;
+    sorted.reserve(tasks.size());
+    auto pending = priorityIndex.begin();
+    auto completed = completedBegin;
+    while (pending != completedBegin && completed != priorityIndex.end()) {
+        if (before(completed->first, pending->first)) sorted.push_back((completed++)->second);
+        else sorted.push_back((pending++)->second);
+    }
+    for (; pending != completedBegin; ++pending) sorted.push_back(pending->second);
+    for (; completed != priorityIndex.end(); ++completed) sorted.push_back(completed->second);
+    return TaskView::of(tasks, std::move(sorted));
+}
+
+// Reads the head of the priority index, where the pending tasks come first
+TaskView TaskManager::getNextTasks(size_t count) const {
+    std::vector<size_t> next;
+    for (auto it = priorityIndex.begin(); it != priorityIndex.end() && next.size() < count; ++it) {
+        if (it->first.completed) break;
+        next.push_back(it->second);
+    }
+    return TaskView::of(tasks, std::move(next));
 }
 
 // Searches tasks by keyword in title or description (case-insensitive)
-std::vector<Task> TaskManager::findTasksByKeyword(const std::string& keyword) const {
+TaskView TaskManager::findTasksByKeyword(const std::string& keyword) const {
     std::string loweredKeyword = parser.parse(keyword);
-    std::vector<Task> result;
-    for (const auto& task : tasks) {
-        std::string loweredTitle = parser.toLower(task.getTitle());
-        std::string loweredDesc = parser.toLower(task.getDescription());
+    std::vector<size_t> result;
+
+    auto matches = [&](size_t index) {
+        return parser.containsIgnoreCase(tasks.title(index), loweredKeyword) ||
+            parser.containsIgnoreCase(tasks.description(index), loweredKeyword);
+    };
 
-        if (loweredTitle.find(loweredKeyword) != std::string::npos ||
-            loweredDesc.find(loweredKeyword) != std::string::npos) {
-            result.push_back(task);
+    // Keywords of 3+ characters are narrowed down by the trigram index, then verified
+    auto candidates = getKeywordIndex().candidates(loweredKeyword);
+    if (candidates) {
+        for (size_t index : *candidates) {
+            if (matches(index)) result.push_back(index);
         }
+        return TaskView::of(tasks, std::move(result));
     }
-    return result;
+
+    for (size_t index = 0; index < tasks.size(); ++index) {
+        if (matches(index)) result.push_back(index);
+    }
+    return TaskView::of(tasks, std::move(result));
+}
+
+// Returns tasks matching a specific tag (case-insensitive), in list order.
+// Read off the tag's posting list, so it costs O(matches) rather than a scan.
+TaskView TaskManager::filterTasksByTag(const std::string& tag) const {
+    std::vector<size_t> indices;
+    if (auto id = tagDictionary.find(parser.parse(tag))) tagDictionary.tasksWith(*id).appendTo(indices);
+    return TaskView::of(tasks, std::move(indices));
+}
+
+// Returns how many tasks carry the given tag (case-insensitive)
+size_t TaskManager::countTasksByTag(const std::string& tag) const {
+    auto id = tagDictionary.find(parser.parse(tag));
+    return id ? tagDictionary.countOf(*id) : 0;
 }
 
-// Returns tasks matching a specific tag (case-insensitive)
-std::vector<Task> TaskManager::filterTasksByTag(const std::string& tag) const {
-    std::string loweredTag = parser.parse(tag);
-    std::vector<Task> result;
+const TagDictionary& TaskManager::getTagDictionary() const {
+    return tagDictionary;
+}
 
-    for (const auto& task : tasks) {
-        if (parser.toLower(task.getTag()) == loweredTag) {
-            result.push_back(task);
+// Runs on the UI thread like every mutation, so the index is not built while one is underway
+const TrigramIndex& TaskManager::getKeywordIndex() const {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    if (!keywordIndexReady) {
+        for (size_t i = 0; i < tasks.size(); ++i) {
+            keywordIndex.add(i, searchTextOf(tasks[i]));
         }
+        keywordIndexReady = true;
     }
-    return result;
+    return keywordIndex;
 }
 
 
-// Returns task by index (const). Displays error if index is invalid
-const Task& TaskManager::getTaskByIndex(size_t index) const {
-    if (index >= getTaskCount() || index < 0) {
-        std::cout << "Invalid task index.\n";
+// Returns tasks due within [from, to], soonest first
+TaskView TaskManager::getTasksDueBetween(std::chrono::system_clock::time_point from,
+    std::chrono::system_clock::time_point to) const {
+    std::vector<size_t> result;
+    auto end = deadlineIndex.upper_bound(to);
+    for (auto it = deadlineIndex.lower_bound(from); it != end; ++it) {
+        result.push_back(it->second);
     }
-    else {
-        return tasks[index];
+    return TaskView::of(tasks, std::move(result));
+}
+
+// Returns tasks due strictly before the given moment, oldest first
+TaskView TaskManager::getTasksDueBefore(std::chrono::system_clock::time_point before) const {
+    std::vector<size_t> result;
+    auto end = deadlineIndex.lower_bound(before);
+    for (auto it = deadlineIndex.begin(); it != end; ++it) {
+        result.push_back(it->second);
     }
+    return TaskView::of(tasks, std::move(result));
 }
 
-// Returns task by index (mutable). Displays error if index is invalid
-Task& TaskManager::getTaskByIndex(size_t index) {
-    if (index >= getTaskCount() || index < 0) {
-        std::cout << "Invalid task index.\n";
+
+// Returns task by index. Throws if index is invalid
+TaskRef TaskManager::getTaskByIndex(size_t index) const {
+    if (index >= getTaskCount()) {
+        throw std::out_of_range("Invalid task index.");
     }
-    else {
-        return tasks[index];
+    return tasks[index];
+}
+
+// Returns the task with the given id. Throws if there is none
+TaskRef TaskManager::getTask(TaskId id) const {
+    auto index = ids.find(id);
+    if (!index) {
+        throw std::out_of_range("No task with id " + std::to_string(id) + ".");
     }
+    return tasks[*index];
+}
+
+// Current position of the task with the given id in getAllTasks()
+std::optional<size_t> TaskManager::indexOf(TaskId id) const {
+    return ids.find(id);
 }
 
 // Displays tasks with deadlines within 48 hours (if incomplete)
 void TaskManager::showUpcomingDeadlines(bool reminder) {
     using namespace std::chrono;
-    std::vector<Task> result;
     auto now = system_clock::now();
     auto soon = now + hours(48);
 
     bool found = false;
-    size_t index = 0;
-    for (const auto& task : getAllTasks()) {
-        auto deadline = task.getDeadline();
-        if (deadline >= now && deadline <= soon && task.getCompleted() == false) {
+    TaskRenderer renderer;
+    for (const auto& entry : getTasksDueBetween(now, soon)) {
+        if (entry.task.getCompleted() == false) {
             if (found == false && reminder == true) {
-                std::cout << "\n[Reminder] Upcoming tasks:\n";
+                renderer.text("\n[Reminder] Upcoming tasks:\n");
                 found = true;
             }
-            std::cout << "[" << index << "] ";
-            task.print();
-            std::cout << "-----------------------------\n";
+            renderer.add(entry.task);
+            renderer.text("-----------------------------\n");
         }
-        index++;
     }
 }
 
@@ -124,49 +460,34 @@ void TaskManager::showUpcomingDeadlines(bool reminder) {
 void TaskManager::showOverduedDeadlines(bool reminder) {
     auto now = std::chrono::system_clock::now();
     bool found = false;
-    size_t index = 0;
-    for (const auto& task : getAllTasks()) {
-        if (task.getDeadline() < now && !task.getCompleted()) { 
+    TaskRenderer renderer;
+    for (const auto& entry : getTasksDueBefore(now)) {
+        if (!entry.task.getCompleted()) {
             if (found == false && reminder == true) {
-                std::cout << "\n[Reminder] Overdued tasks:\n";
+                renderer.text("\n[Reminder] Overdued tasks:\n");
                 found = true;
             }
-            std::cout << "[" << index << "] ";
-            task.print();
-            std::cout << "-----------------------------\n";
+            renderer.add(entry.task);
+            renderer.text("-----------------------------\n");
         }
-        index++;
     }
 
-    if (reminder && found) std::cout << ">";
+    if (reminder && found) renderer.text(">");
 }
 
-// Counts upcoming tasks within 48 hours (incomplete)
+// Counts upcoming tasks within 48 hours (incomplete). A sequential pass over the deadline
+// column and completion bits beats walking the deadline index node by node.
 int TaskManager::countUpcomingDeadlines() {
     using namespace std::chrono;
     auto now = system_clock::now();
     auto soon = now + hours(48);
-
-    size_t count= 0;
-    for (const auto& task : getAllTasks()) {
-        auto deadline = task.getDeadline();
-        if (deadline >= now && deadline <= soon && task.getCompleted() == false) {
-            count++;
-        }
-    }
-
-    return count;
+    return static_cast<int>(tasks.countIncompleteDue(TaskTable::toTicks(now), TaskTable::toTicks(soon)));
 }
+
+// Counts overdue tasks (incomplete)
 int TaskManager::countOverduedDeadlines() {
     auto now = std::chrono::system_clock::now();
-    size_t count = 0;
-    for (const auto& task : getAllTasks()) {
-        if (task.getDeadline() < now && !task.getCompleted()) {  // ,      
-            count++;
-        }
-    }
-
-    return count;
+    return static_cast<int>(tasks.countIncompleteDue(INT64_MIN, TaskTable::toTicks(now) - 1));
 }
 
 size_t TaskManager::getTaskCount() const {
@@ -174,29 +495,308 @@ size_t TaskManager::getTaskCount() const {
 }
 
 void TaskManager::clearTasks() {
+    std::lock_guard<std::mutex> lock(stateMutex);
     tasks.clear();
+    ids.clear();
+    deadlineIndex.clear();
+    priorityIndex.clear();
+    keywordIndex.clear();
+    keywordIndexReady = true;
+    tagDictionary.clear();
+    generation++;
+    notifyMutation();
+}
+
+static std::string journalPathFor(const std::string& filename) {
+    return filename + ".journal";
+}
+
+// Drops a torn record left at the end of a journal, so records appended later start on a
+// fresh line, and reports records that had to be skipped. Returns whether any were.
+static bool finishReplay(const std::string& path, const JournalReplay& replay) {
+    std::error_code ec;
+    std::uintmax_t size = std::filesystem::file_size(path, ec);
+    if (!ec && size > replay.intactBytes) std::filesystem::resize_file(path, replay.intactBytes);
+
+    for (std::uintmax_t offset : replay.corruptOffsets) {
+        std::cerr << "Skipped a corrupt journal record at byte " << offset << " of " << path << '\n';
+    }
+    return !replay.corruptOffsets.empty();
 }
 
-// Saves all tasks to file using Json storage backend
+// Saves all tasks to file using the storage backend matching its extension.
+// A full save of the loaded file folds its journal into the new snapshot.
+// Runs on the UI thread, the only writer, so the task list is read without stateMutex.
 void TaskManager::saveTasks(const std::string& filename) {
+    std::unique_lock<std::mutex> writing(compactionMutex, std::defer_lock);
+    if (filename == storageFile) writing.lock(); // don't interleave with a background compaction
+
     try {
-        storage.saveToFile(filename, getAllTasks());
+        auto backend = filename == storageFile && storage ? storage : TaskStorage::forFile(filename);
+        TaskFileExtras extras;
+        extras.ids = ids.state();
+        if (backend->savesIndexOrders()) saveIndexOrders(extras);
+        backend->saveToFile(filename, getAllTasks(), &extras);
+
+        if (filename == storageFile) {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            if (!journal.isOpen()) journal.open(journalPathFor(storageFile));
+            journal.truncate();
+            std::error_code ec;
+            std::filesystem::remove(TaskJournal::sealedPathFor(journal.getPath()), ec);
+            compactionPending = false;
+        }
     }
     catch (const std::exception& e) {
         std::cerr << "Error saving tasks: " << e.what() << '\n';
     }
 }
 
-// Loads tasks from file using Json storage backend
+// Loads tasks from file using the storage backend matching its extension,
+// then replays the mutations journaled since that snapshot was written
 void TaskManager::loadTasks(const std::string& filename) {
+    std::lock_guard<std::mutex> writing(compactionMutex); // let an in-flight snapshot finish first
+    {
+        // No storage file while loading, so background commits leave the journals alone
+        std::lock_guard<std::mutex> lock(stateMutex);
+        journal.close();
+        loadEpoch++;
+        storageFile.clear();
+        storage.reset();
+        compactionPending = false;
+        loading = true;
+    }
+
     try {
         clearTasks();
-        auto tasks = storage.loadFromFile(filename);
-        for (const auto& task : tasks) {
-            addTask(task);
-        }
+        std::shared_ptr<TaskStorage> backend = TaskStorage::forFile(filename);
+        TaskFileExtras extras;
+        TaskTable loaded = backend->loadFromFile(filename, &extras);
+
+        std::lock_guard<std::mutex> lock(stateMutex);
+        storage = std::move(backend);
+        tasks = std::move(loaded);
+        restoreIds(extras.ids);
+        rebuildIndexes(extras);
+        generation++;
     }
     catch (const std::exception& e) {
         std::cerr << "Error loading tasks: " << e.what() << '\n';
+        std::cerr << "Changes will not be saved to " << filename << " until it loads.\n";
+        // No storage file: committing would overwrite the unreadable snapshot and drop its journal
+        std::lock_guard<std::mutex> lock(stateMutex);
+        loading = false;
+        notifyMutation();
+        return;
+    }
+
+    try {
+        const std::string journalPath = journalPathFor(filename);
+        const std::string sealedPath = TaskJournal::sealedPathFor(journalPath);
+
+        // A sealed journal is left behind if a background compaction was interrupted.
+        // It still applies unless the snapshot was written after it was sealed.
+        bool sealedApplies = std::filesystem::exists(sealedPath);
+        if (sealedApplies && std::filesystem::exists(filename) &&
+            std::filesystem::last_write_time(filename) >= std::filesystem::last_write_time(sealedPath)) {
+            std::filesystem::remove(sealedPath);
+            sealedApplies = false;
+        }
+
+        // The journal is closed while replaying, so replayed mutations are not logged again
+        auto apply = [this](const JournalRecord& record) { applyJournalRecord(record); };
+        bool skipped = sealedApplies && finishReplay(sealedPath, TaskJournal::replay(sealedPath, apply));
+        skipped = finishReplay(journalPath, TaskJournal::replay(journalPath, apply)) || skipped;
+
+        std::lock_guard<std::mutex> lock(stateMutex);
+        storageFile = filename;
+        if (skipped) compactionPending = true; // the next snapshot leaves the corrupt records behind
+        journal.open(journalPath);
+        if (sealedApplies) journal.unseal(sealedPath);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error replaying journal: " << e.what() << '\n';
+        std::lock_guard<std::mutex> lock(stateMutex);
+        storageFile = filename;
+        compactionPending = true;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        loading = false;
+    }
+    notifyMutation();
+}
+
+void TaskManager::applyJournalRecord(const JournalRecord& record) {
+    switch (record.op) {
+    case JournalRecord::Op::Add: insertTask(record.task, true); break;
+    case JournalRecord::Op::Edit: editTask(record.id, record.task); break;
+    case JournalRecord::Op::Remove: removeTask(record.id); break;
+    case JournalRecord::Op::SetCompleted: setCompleted(record.id, record.completed); break;
+    }
+}
+
+// Registers the ids tasks were saved with, then the free slots as saved, so ids of tasks
+// deleted before the save stay unused. Tasks without an id (files from before ids) or
+// with a duplicate get fresh ids, which reach the file with the next snapshot.
+void TaskManager::restoreIds(const std::optional<SlotMapState>& saved) {
+    ids.clear();
+    std::vector<size_t> unassigned;
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        if (!ids.restore(tasks.id(i), i)) unassigned.push_back(i);
+    }
+    if (saved) ids.restoreFree(*saved);
+    for (size_t i : unassigned) {
+        tasks.setId(i, ids.insert(i));
+    }
+    if (!unassigned.empty()) compactionPending = true;
+}
+
+ImportStats TaskManager::importTasks(const std::string& filename) {
+    TaskImporter importer(transferFormatForFile(filename));
+    std::ifstream in(filename, std::ios::binary);
+    if (!in.is_open()) throw std::runtime_error("Cannot open file: " + filename);
+
+    ImportStats stats;
+    try {
+        stats = importer.run(in, [this](std::vector<Task>&& batch) { appendTasks(std::move(batch)); });
+    }
+    catch (...) {
+        finishAppend(); // keep what was appended before the failure consistent
+        throw;
+    }
+    finishAppend();
+    return stats;
+}
+
+// Runs on the UI thread, the only writer, so the task list is read without stateMutex
+size_t TaskManager::exportTasks(const std::string& filename) {
+    TaskExporter exporter(transferFormatForFile(filename));
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) throw std::runtime_error("Cannot create file: " + filename);
+    exporter.run(tasks, out);
+    return tasks.size();
+}
+
+// Group-commits pending journal records; once the journal grows past the
+// threshold it is compacted into a fresh snapshot of the loaded file
+void TaskManager::commitChanges() {
+    bool compact = false;
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        if (storageFile.empty()) return;
+
+        try {
+            journal.commit();
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Error writing journal: " << e.what() << '\n';
+            compactionPending = true;
+        }
+        compact = compactionPending || !journal.isOpen() || journal.size() > journalCompactionBytes;
+    }
+
+    if (compact) saveTasks(storageFile);
+}
+
+uint64_t TaskManager::getGeneration() const {
+    return generation.load();
+}
+
+// Returns the published snapshot if it is still current; otherwise copies and publishes a new one
+std::shared_ptr<const TaskSnapshot> TaskManager::snapshot() const {
+    auto current = std::atomic_load(&published);
+    if (current && current->generation == generation.load()) return current;
+
+    std::lock_guard<std::mutex> lock(stateMutex);
+    return snapshotLocked();
+}
+
+std::shared_ptr<const TaskSnapshot> TaskManager::snapshotLocked() const {
+    auto current = std::atomic_load(&published);
+    if (current && current->generation == generation.load()) return current; // another reader just copied it
+
+    auto fresh = std::make_shared<TaskSnapshot>();
+    fresh->generation = generation.load();
+    fresh->tasks = tasks; // shares the column pages and text chunks, copies none of them
+
+    std::shared_ptr<const TaskSnapshot> result = std::move(fresh);
+    std::atomic_store(&published, result);
+    return result;
+}
+
+size_t TaskManager::addMutationListener(std::function<void()> listener) {
+    std::lock_guard<std::mutex> lock(listenerMutex);
+    mutationListeners.emplace(nextListenerId, std::move(listener));
+    return nextListenerId++;
+}
+
+void TaskManager::removeMutationListener(size_t id) {
+    std::lock_guard<std::mutex> lock(listenerMutex);
+    mutationListeners.erase(id);
+}
+
+void TaskManager::notifyMutation() {
+    if (loading) return;
+    std::lock_guard<std::mutex> lock(listenerMutex);
+    for (const auto& entry : mutationListeners) {
+        entry.second();
+    }
+}
+
+std::optional<TaskManager::Compaction> TaskManager::commitChangesDeferred() {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    if (storageFile.empty()) return std::nullopt;
+
+    try {
+        journal.commit();
+        if (!compactionPending && journal.isOpen() && journal.size() <= journalCompactionBytes) {
+            return std::nullopt;
+        }
+        if (!journal.isOpen()) journal.open(journalPathFor(storageFile));
+
+        Compaction compaction{ storageFile, storage ? storage : TaskStorage::forFile(storageFile), snapshotLocked(), ids.state(), journal.seal(), loadEpoch };
+        compactionPending = false;
+        return compaction;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error writing journal: " << e.what() << '\n';
+        compactionPending = true;
+        throw;
+    }
+}
+
+// Writes the compaction snapshot to disk; touches no task state, so callers need no lock
+bool TaskManager::writeCompaction(const Compaction& compaction) {
+    std::lock_guard<std::mutex> writing(compactionMutex);
+    try {
+        TaskFileExtras extras;
+        extras.ids = compaction.ids;
+        if (compaction.storage->savesIndexOrders()) sortIndexOrders(compaction.snapshot->tasks, extras);
+        compaction.storage->saveToFile(compaction.filename, compaction.snapshot->tasks, &extras);
+        return true;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error saving tasks: " << e.what() << '\n';
+        return false;
+    }
+}
+
+// Drops the sealed journal once the snapshot containing it is on disk, or merges it back otherwise
+void TaskManager::finishCompaction(const Compaction& compaction, bool written) {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    if (compaction.loadEpoch != loadEpoch) return; // a reload already reconciled the sealed journal
+
+    try {
+        if (written) std::filesystem::remove(compaction.sealedJournal);
+        else {
+            journal.unseal(compaction.sealedJournal);
+            compactionPending = true;
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error finishing compaction: " << e.what() << '\n';
+        compactionPending = true;
     }
 }
\ No newline at end of file
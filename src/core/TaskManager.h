@@ -1,33 +1,144 @@
 #pragma once
 
 #include "Task.h"
+#include "TaskTable.h"
+#include "TrigramIndex.h"
+#include "TagDictionary.h"
+#include "TaskView.h"
+#include "TaskSnapshot.h"
+#include "SlotMap.h"
 #include <vector>
+#include <map>
 #include <optional>
 #include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <functional>
 #include "CommandParser.h"
-#include "JsonStorage.h"
+#include "TaskStorage.h"
+#include "TaskJournal.h"
+#include "TaskTransfer.h"
+
+// Ordered deadline -> task index mapping, kept in sync with the task list
+using DeadlineIndex = std::multimap<std::chrono::system_clock::time_point, size_t>;
+
+// Key of the composite "what next" order: highest priority first, then soonest deadline,
+// then lowest id. Completed tasks all sort after the pending ones, so the pending tasks
+// form a prefix that top-K reads without stepping over finished work.
+struct PriorityKey {
+    bool completed;
+    uint8_t priority;
+    int64_t deadline; // TaskTable ticks
+    TaskId id;
+
+    bool operator<(const PriorityKey& other) const {
+        if (completed != other.completed) return !completed;
+        if (priority != other.priority) return priority > other.priority;
+        if (deadline != other.deadline) return deadline < other.deadline;
+        return id < other.id;
+    }
+};
+
+// Composite order -> task index mapping, kept in sync with the task list
+using PriorityIndex = std::map<PriorityKey, size_t>;
 
 class TaskManager {
+public:
+    // Snapshot handed to a background writer, plus the journal it supersedes
+    struct Compaction {
+        std::string filename;
+        std::shared_ptr<TaskStorage> storage;
+        std::shared_ptr<const TaskSnapshot> snapshot;
+        SlotMapState ids; // taken with the snapshot, so the file never reissues an id it dropped
+        std::string sealedJournal;
+        uint64_t loadEpoch = 0;
+    };
+
 private:
-    std::vector<Task> tasks;
+    TaskTable tasks; // columns of every task; positions are the indices all indexes refer to
+    SlotMap ids; // task id -> position in tasks
+    DeadlineIndex deadlineIndex;
+    PriorityIndex priorityIndex;
+    // Built on the first keyword lookup after a bulk load rather than during it, since it costs
+    // more than the rest of a load together; until then mutations leave it alone
+    mutable TrigramIndex keywordIndex;
+    mutable bool keywordIndexReady = true;
+    TagDictionary tagDictionary;
     CommandParser parser;
-    JsonStorage storage;
+
+    // Mutations since the last snapshot of storageFile are appended to its journal
+    static constexpr std::uintmax_t journalCompactionBytes = 4 * 1024 * 1024;
+    std::string storageFile;
+    std::shared_ptr<TaskStorage> storage; // the backend storageFile was loaded with, so saves keep its format
+    TaskJournal journal;
+    bool compactionPending = false;
+    std::atomic<uint64_t> generation{ 0 };
+    uint64_t loadEpoch = 0;
+    std::mutex compactionMutex; // held while a compaction snapshot is being written
+
+    // Only the UI thread mutates; stateMutex orders its mutations and journal writes against
+    // background threads copying a snapshot or committing the journal. Readers of a published
+    // snapshot never take it.
+    mutable std::mutex stateMutex;
+    mutable std::shared_ptr<const TaskSnapshot> published;
+    std::shared_ptr<const TaskSnapshot> snapshotLocked() const;
+
+    std::mutex listenerMutex;
+    std::map<size_t, std::function<void()>> mutationListeners;
+    size_t nextListenerId = 0;
+    bool loading = false; // set and cleared under stateMutex; a load notifies once when done instead of once per replayed record
+    void notifyMutation();
+
+    // Bulk import appends batches unindexed from appendStart on, then indexes them in one pass
+    std::optional<size_t> appendStart;
+    void appendTasks(std::vector<Task>&& batch);
+    void finishAppend();
+
+    TaskId insertTask(const Task& task, bool keepId);
+    void restoreIds(const std::optional<SlotMapState>& saved);
+    void applyJournalRecord(const JournalRecord& record);
+    void indexTask(size_t index);
+    DeadlineIndex::iterator deadlineEntry(size_t index);
+    PriorityKey priorityKeyOf(size_t index) const;
+    PriorityIndex::iterator priorityEntry(size_t index);
+    void rebuildIndexes(const TaskFileExtras& saved);
+    void indexTasksFrom(size_t first, const TaskFileExtras* saved = nullptr);
+    void saveIndexOrders(TaskFileExtras& extras) const;
 
 public:
-    void addTask(const Task& task);
-    bool removeTask(size_t index);
-    bool editTask(size_t index, const Task& newTask);
+    // Tasks are addressed by stable ids: positions in the list change when a task is removed
+    // (the last task takes its place), ids never do. Each returns false for an unknown id.
+    TaskId addTask(const Task& task);
+    bool removeTask(TaskId id);
+    bool editTask(TaskId id, const Task& newTask);
+    bool setCompleted(TaskId id, bool completed);
 
-    const std::vector<Task>& getAllTasks() const;
+    const TaskTable& getAllTasks() const;
+    const DeadlineIndex& getDeadlineIndex() const;
+    const PriorityIndex& getPriorityIndex() const;
 
-    std::vector<Task> getTasksSortedByDeadline() const;
-    std::vector<Task> getTasksSortedByPriority() const;
+    // Query results are views into the task list; they stay valid until the next mutation
+    TaskView getTasksSortedByDeadline() const;
+    // Highest priority first, then soonest deadline, then lowest id
+    TaskView getTasksSortedByPriority() const;
+    // The first `count` pending tasks in that order ("show my next 10"); costs O(count),
+    // whatever the number of tasks
+    TaskView getNextTasks(size_t count) const;
 
-    std::vector<Task> findTasksByKeyword(const std::string& keyword) const;
-    std::vector<Task> filterTasksByTag(const std::string& tag) const;
+    TaskView findTasksByKeyword(const std::string& keyword) const;
+    TaskView filterTasksByTag(const std::string& tag) const;
+    size_t countTasksByTag(const std::string& tag) const;
+    const TagDictionary& getTagDictionary() const;
+    const TrigramIndex& getKeywordIndex() const;
 
-    const Task& getTaskByIndex(size_t index) const;
-    Task& getTaskByIndex(size_t index);
+    TaskView getTasksDueBetween(std::chrono::system_clock::time_point from,
+        std::chrono::system_clock::time_point to) const;
+    TaskView getTasksDueBefore(std::chrono::system_clock::time_point before) const;
+
+    TaskRef getTaskByIndex(size_t index) const;
+    TaskRef getTask(TaskId id) const;
+    std::optional<size_t> indexOf(TaskId id) const;
     void showUpcomingDeadlines(bool reminder = false);
     void showOverduedDeadlines(bool reminder = false);
     int countUpcomingDeadlines();
@@ -36,4 +147,30 @@ public:
     void clearTasks();
     void saveTasks(const std::string& filename);
     void loadTasks(const std::string& filename);
+    void commitChanges();
+
+    // Streams tasks in from a CSV or NDJSON file (format by extension) and appends them.
+    // The import is not journaled task by task: the next commit writes a full snapshot instead.
+    ImportStats importTasks(const std::string& filename);
+    // Writes every task to a CSV or NDJSON file; returns how many were written
+    size_t exportTasks(const std::string& filename);
+
+    // Bumped by every mutation; lets readers cheaply detect that nothing changed
+    uint64_t getGeneration() const;
+
+    // Immutable view of the current tasks, safe to read from any thread without locking.
+    // Copied at most once per generation and shared by every reader of that generation.
+    std::shared_ptr<const TaskSnapshot> snapshot() const;
+
+    // Listeners are called on the mutating thread after every change (and once after a load);
+    // they must be quick and must not call back into the TaskManager
+    size_t addMutationListener(std::function<void()> listener);
+    void removeMutationListener(size_t id);
+
+    // Like commitChanges(), but when compaction is due it only seals the journal and returns a
+    // snapshot of the tasks, so it can be serialized without holding any lock.
+    // Rethrows (after reporting it) when the journal could not be written.
+    std::optional<Compaction> commitChangesDeferred();
+    bool writeCompaction(const Compaction& compaction);
+    void finishCompaction(const Compaction& compaction, bool written);
 };
\ No newline at end of file
@@ -0,0 +1,272 @@
+#include "TaskQuery.h"
+#include "DateTimeUtils.h"
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+
+// Parser for the small task query language (see TaskQuery.h for the grammar)
+
+namespace {
+    using namespace std::chrono;
+
+    struct Token {
+        enum class Kind { Word, Operator, End };
+        Kind kind = Kind::End;
+        std::string text;
+    };
+
+    std::string lowered(std::string text) {
+        std::transform(text.begin(), text.end(), text.begin(), [](unsigned char ch) { return std::tolower(ch); });
+        return text;
+    }
+
+    // Words are lowercased whether quoted or not: tags, keywords and every keyword of the
+    // language compare case-insensitively, and dates have no letters to fold
+    std::vector<Token> tokenize(const std::string& text) {
+        std::vector<Token> tokens;
+        size_t i = 0;
+        while (i < text.size()) {
+            unsigned char c = text[i];
+            if (std::isspace(c)) { ++i; continue; }
+
+            if (c == '"' || c == '\'') {
+                size_t close = text.find(static_cast<char>(c), i + 1);
+                if (close == std::string::npos) throw std::runtime_error("Unterminated quote in query");
+                tokens.push_back({ Token::Kind::Word, lowered(text.substr(i + 1, close - i - 1)) });
+                i = close + 1;
+                continue;
+            }
+
+            if (c == '!' || c == '<' || c == '>' || c == '=' || c == '~') {
+                std::string op(1, static_cast<char>(c));
+                if (c != '~' && i + 1 < text.size() && text[i + 1] == '=') op += '=';
+                if (op == "!") throw std::runtime_error("Unexpected '!' in query");
+                tokens.push_back({ Token::Kind::Operator, op });
+                i += op.size();
+                continue;
+            }
+
+            size_t start = i;
+            while (i < text.size() && !std::isspace(static_cast<unsigned char>(text[i])) &&
+                std::string("!<>=~\"'").find(text[i]) == std::string::npos) {
+                ++i;
+            }
+            tokens.push_back({ Token::Kind::Word, lowered(text.substr(start, i - start)) });
+        }
+        tokens.push_back({ Token::Kind::End, "" });
+        return tokens;
+    }
+
+    class QueryParser {
+    public:
+        explicit QueryParser(const std::string& text)
+            : tokens(tokenize(text)), now(system_clock::now()) {
+        }
+
+        TaskQuery run() {
+            if (peek().kind != Token::Kind::End && peek().text != "order" && peek().text != "limit") {
+                parseCondition();
+                while (acceptWord("and")) parseCondition();
+            }
+            if (acceptWord("order")) {
+                expectWord("by");
+                std::string field = word("sort field");
+                if (field == "deadline" || field == "due") query.orderBy = TaskQuery::OrderField::Deadline;
+                else if (field == "priority") query.orderBy = TaskQuery::OrderField::Priority;
+                else if (field == "title") query.orderBy = TaskQuery::OrderField::Title;
+                else throw std::runtime_error("Cannot order by '" + field + "'");
+
+                if (acceptWord("desc")) query.descending = true;
+                else acceptWord("asc");
+            }
+            if (acceptWord("limit")) {
+                std::string count = word("limit");
+                try {
+                    size_t used = 0;
+                    query.limit = std::stoul(count, &used);
+                    if (used != count.size()) throw std::invalid_argument(count);
+                }
+                catch (const std::exception&) {
+                    throw std::runtime_error("Invalid limit '" + count + "'");
+                }
+            }
+            if (peek().kind != Token::Kind::End) {
+                throw std::runtime_error("Unexpected '" + peek().text + "' in query");
+            }
+            return query;
+        }
+
+    private:
+        const Token& peek() const { return tokens[position]; }
+        const Token& next() { return tokens[position < tokens.size() - 1 ? position++ : position]; }
+
+        bool acceptWord(const std::string& text) {
+            if (peek().kind == Token::Kind::Word && peek().text == text) { ++position; return true; }
+            return false;
+        }
+
+        void expectWord(const std::string& text) {
+            if (!acceptWord(text)) throw std::runtime_error("Expected '" + text + "' in query");
+        }
+
+        std::string word(const char* what) {
+            const Token& token = next();
+            if (token.kind != Token::Kind::Word) throw std::runtime_error(std::string("Expected ") + what + " in query");
+            return token.text;
+        }
+
+        std::string op(const char* field) {
+            const Token& token = next();
+            if (token.kind != Token::Kind::Operator) throw std::runtime_error(std::string("Expected an operator after '") + field + "'");
+            return token.text;
+        }
+
+        void parseCondition() {
+            std::string field = word("a condition");
+
+            if (field == "not") {
+                expectWord("completed");
+                query.completed = false;
+            }
+            else if (field == "completed") {
+                if (peek().kind == Token::Kind::Operator) {
+                    std::string o = op("completed");
+                    bool value = parseBool(word("yes or no"));
+                    if (o == "=") query.completed = value;
+                    else if (o == "!=") query.completed = !value;
+                    else throw std::runtime_error("'completed' only supports = and !=");
+                }
+                else query.completed = true;
+            }
+            else if (field == "overdue") {
+                restrictOverdue();
+            }
+            else if (field == "today") {
+                restrictToday();
+            }
+            else if (field == "upcoming") {
+                restrictDue(now, now + hours(48) + system_clock::duration(1));
+            }
+            else if (field == "tag") {
+                std::string o = op("tag");
+                std::string value = word("a tag");
+                if (o == "=") query.tags.push_back(value);
+                else if (o == "!=") query.excludedTags.push_back(value);
+                else throw std::runtime_error("'tag' only supports = and !=");
+            }
+            else if (field == "text" || field == "title" || field == "keyword") {
+                std::string o = op("text");
+                if (o != "~") throw std::runtime_error("'text' only supports ~");
+                query.keywords.push_back(word("a keyword"));
+            }
+            else if (field == "priority") {
+                std::string o = op("priority");
+                int value = parsePriority(word("a priority"));
+                if (o == "=") { query.minPriority = std::max(query.minPriority, value); query.maxPriority = std::min(query.maxPriority, value); }
+                else if (o == ">=") query.minPriority = std::max(query.minPriority, value);
+                else if (o == ">") query.minPriority = std::max(query.minPriority, value + 1);
+                else if (o == "<=") query.maxPriority = std::min(query.maxPriority, value);
+                else if (o == "<") query.maxPriority = std::min(query.maxPriority, value - 1);
+                else throw std::runtime_error("'priority' does not support '" + o + "'");
+            }
+            else if (field == "due" || field == "deadline") {
+                parseDue();
+            }
+            else {
+                throw std::runtime_error("Unknown condition '" + field + "'");
+            }
+        }
+
+        void parseDue() {
+            if (acceptWord("within")) {
+                restrictDue(now, now + parseSpan(word("a time span")) + system_clock::duration(1));
+                return;
+            }
+
+            std::string o = op("due");
+            if (o == "=") {
+                std::string value = word("today or overdue");
+                if (value == "today") restrictToday();
+                else if (value == "overdue") restrictOverdue();
+                else throw std::runtime_error("'due =' expects today or overdue");
+                return;
+            }
+
+            TaskQuery::TimePoint at = parseTime(word("a time"));
+            const auto tick = system_clock::duration(1);
+            if (o == "<") restrictDue(std::nullopt, at);
+            else if (o == "<=") restrictDue(std::nullopt, at + tick);
+            else if (o == ">") restrictDue(at + tick, std::nullopt);
+            else if (o == ">=") restrictDue(at, std::nullopt);
+            else throw std::runtime_error("'due' does not support '" + o + "'");
+        }
+
+        // Past the deadline and still open
+        void restrictOverdue() {
+            restrictDue(std::nullopt, now);
+            query.completed = false;
+        }
+
+        void restrictToday() {
+            restrictDue(DateTimeUtils::startOfDay(now), DateTimeUtils::endOfDay(now) + system_clock::duration(1));
+        }
+
+        // Narrows the deadline window to [from, before)
+        void restrictDue(std::optional<TaskQuery::TimePoint> from, std::optional<TaskQuery::TimePoint> before) {
+            if (from && (!query.dueFrom || *from > *query.dueFrom)) query.dueFrom = from;
+            if (before && (!query.dueBefore || *before < *query.dueBefore)) query.dueBefore = before;
+        }
+
+        TaskQuery::TimePoint parseTime(const std::string& value) {
+            if (value == "now") return now;
+            if (!value.empty() && std::isdigit(static_cast<unsigned char>(value.back())) && value.find('-') != std::string::npos) {
+                // Absolute date; time and seconds are optional
+                std::string full = value;
+                auto colons = std::count(full.begin(), full.end(), ':');
+                if (colons == 0) full += " 00:00:00";
+                else if (colons == 1) full += ":00";
+                return DateTimeUtils::stringToTimePoint(full);
+            }
+            return now + parseSpan(value);
+        }
+
+        static system_clock::duration parseSpan(const std::string& value) {
+            size_t used = 0;
+            long long amount = 0;
+            try {
+                amount = std::stoll(value, &used);
+            }
+            catch (const std::exception&) {
+                throw std::runtime_error("Invalid time '" + value + "'");
+            }
+            std::string unit = value.substr(used);
+            if (unit == "m" || unit == "min") return minutes(amount);
+            if (unit == "h") return hours(amount);
+            if (unit == "d") return hours(24 * amount);
+            if (unit == "w") return hours(24 * 7 * amount);
+            throw std::runtime_error("Invalid time unit in '" + value + "' (use m, h, d or w)");
+        }
+
+        static bool parseBool(const std::string& value) {
+            if (value == "yes" || value == "y" || value == "true" || value == "1") return true;
+            if (value == "no" || value == "n" || value == "false" || value == "0") return false;
+            throw std::runtime_error("Expected yes or no, got '" + value + "'");
+        }
+
+        static int parsePriority(const std::string& value) {
+            if (value == "low" || value == "0") return 0;
+            if (value == "medium" || value == "1") return 1;
+            if (value == "high" || value == "2") return 2;
+            throw std::runtime_error("Unknown priority '" + value + "'");
+        }
+
+        std::vector<Token> tokens;
+        size_t position = 0;
+        TaskQuery::TimePoint now;
+        TaskQuery query;
+    };
+}
+
+TaskQuery TaskQuery::parse(const std::string& text) {
+    return QueryParser(text).run();
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <chrono>
+#include <optional>
+#include <string>
+#include <vector>
+
+// A conjunctive task query, e.g.
+//   tag=work and due within 7d and not completed and priority=high order by deadline limit 10
+//
+// Conditions (joined with "and"):
+//   tag = <name> | tag != <name>
+//   text ~ <word>                       keyword in title or description
+//   priority (=|<|<=|>|>=) low|medium|high
+//   completed | not completed | completed = yes|no
+//   due (<|<=|>|>=) <time> | due within <span> | due = today|overdue
+//   overdue | today | upcoming          shorthands for common windows (overdue implies not completed)
+// where <time> is now, a span from now (30m, 48h, 7d, 2w) or a quoted "YYYY-MM-DD HH:MM:SS".
+// Tags and keywords match case-insensitively, quoted or not.
+// Clauses: order by deadline|priority|title [asc|desc], limit <n>
+struct TaskQuery {
+    using TimePoint = std::chrono::system_clock::time_point;
+
+    enum class OrderField { None, Deadline, Priority, Title };
+
+    std::vector<std::string> tags;          // lowercased; every one must match
+    std::vector<std::string> excludedTags;  // lowercased
+    std::vector<std::string> keywords;      // lowercased
+    std::optional<TimePoint> dueFrom;       // inclusive
+    std::optional<TimePoint> dueBefore;     // exclusive
+    std::optional<bool> completed;
+    int minPriority = 0;
+    int maxPriority = 2;
+
+    OrderField orderBy = OrderField::None;
+    bool descending = false;
+    std::optional<size_t> limit;
+
+    // Throws std::runtime_error describing the first problem in the text
+    static TaskQuery parse(const std::string& text);
+};
\ No newline at end of file
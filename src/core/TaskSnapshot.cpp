@@ -0,0 +1,38 @@
+#include "TaskSnapshot.h"
+#include <algorithm>
+
+// Range queries over a published snapshot. The snapshot keeps no deadline order of its own
+// (building one would cost O(n) under the manager's lock on every publish), so they scan
+// the deadline column and sort only the matches.
+
+// Tasks with from <= deadline <= to (in ticks), soonest first; equal deadlines in list order
+TaskView TaskSnapshot::dueWithin(int64_t from, int64_t to) const {
+    const auto& deadlines = tasks.deadlineColumn();
+    std::vector<size_t> due;
+    for (size_t index = 0; index < deadlines.size(); ++index) {
+        if (deadlines[index] >= from && deadlines[index] <= to) due.push_back(index);
+    }
+    std::sort(due.begin(), due.end(), [&deadlines](size_t a, size_t b) {
+        return deadlines[a] != deadlines[b] ? deadlines[a] < deadlines[b] : a < b;
+    });
+    return TaskView::of(tasks, std::move(due));
+}
+
+TaskView TaskSnapshot::dueBetween(std::chrono::system_clock::time_point from,
+    std::chrono::system_clock::time_point to) const {
+    return dueWithin(TaskTable::toTicks(from), TaskTable::toTicks(to));
+}
+
+TaskView TaskSnapshot::dueBefore(std::chrono::system_clock::time_point before) const {
+    return dueWithin(INT64_MIN, TaskTable::toTicks(before) - 1);
+}
+
+// One vectorized pass over the deadline column and the completion bits
+size_t TaskSnapshot::countIncompleteDueBetween(std::chrono::system_clock::time_point from,
+    std::chrono::system_clock::time_point to) const {
+    return tasks.countIncompleteDue(TaskTable::toTicks(from), TaskTable::toTicks(to));
+}
+
+size_t TaskSnapshot::countIncompleteDueBefore(std::chrono::system_clock::time_point before) const {
+    return tasks.countIncompleteDue(INT64_MIN, TaskTable::toTicks(before) - 1);
+}
\ No newline at end of file
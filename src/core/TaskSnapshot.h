@@ -0,0 +1,29 @@
+#pragma once
+
+#include "TaskView.h"
+#include <vector>
+#include <chrono>
+#include <cstdint>
+
+// Immutable copy of the task list as of one generation. The TaskManager publishes
+// it behind a shared_ptr, so reader threads keep a consistent view without locking
+// while the UI thread goes on mutating (and later publishes a newer snapshot).
+// The copy shares every column page with the live table (see ChunkedColumn), so
+// publishing costs a pointer per page and the pages edited afterwards are the only ones copied.
+struct TaskSnapshot {
+    uint64_t generation = 0;
+    TaskTable tasks;
+
+    // Tasks due within [from, to], soonest first
+    TaskView dueBetween(std::chrono::system_clock::time_point from,
+        std::chrono::system_clock::time_point to) const;
+    // Tasks due strictly before the given moment, oldest first
+    TaskView dueBefore(std::chrono::system_clock::time_point before) const;
+
+    size_t countIncompleteDueBetween(std::chrono::system_clock::time_point from,
+        std::chrono::system_clock::time_point to) const;
+    size_t countIncompleteDueBefore(std::chrono::system_clock::time_point before) const;
+
+private:
+    TaskView dueWithin(int64_t from, int64_t to) const;
+};
\ No newline at end of file
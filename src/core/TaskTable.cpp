@@ -0,0 +1,281 @@
+#include "TaskTable.h"
+#include <utility>
+#include "DateTimeUtils.h"
+#include "TaskRenderer.h"
+#include "DeadlineKernels.h"
+
+using json = nlohmann::json;
+
+// Column-wise task storage and its row facade
+
+std::string_view TaskRef::getTitle() const {
+    return table->title(index);
+}
+
+std::string_view TaskRef::getDescription() const {
+    return table->description(index);
+}
+
+std::chrono::system_clock::time_point TaskRef::getDeadline() const {
+    return table->deadline(index);
+}
+
+Priority TaskRef::getPriority() const {
+    return table->priority(index);
+}
+
+std::string_view TaskRef::getTag() const {
+    return table->tag(index);
+}
+
+bool TaskRef::getCompleted() const {
+    return table->completed(index);
+}
+
+TaskId TaskRef::getId() const {
+    return table->id(index);
+}
+
+Task TaskRef::toTask() const {
+    Task task(std::string(getTitle()), std::string(getDescription()), getDeadline(), getPriority(),
+        std::string(getTag()), getCompleted());
+    task.setId(getId());
+    return task;
+}
+
+void TaskRef::print() const {
+    TaskRenderer renderer;
+    renderer.add(*this);
+}
+
+// Same fields as to_json(Task), read straight from the columns
+void to_json(json& j, const TaskRef& task) {
+    j = json{
+        {"title", std::string(task.getTitle())},
+        {"description", std::string(task.getDescription())},
+        {"deadline", DateTimeUtils::timePointToString(task.getDeadline())},
+        {"priority", static_cast<int>(task.getPriority())},
+        {"tag", std::string(task.getTag())},
+        {"completed", task.getCompleted()}
+    };
+    if (task.getId() != 0) j["id"] = task.getId();
+}
+
+size_t TaskTable::size() const {
+    return deadlines.size();
+}
+
+bool TaskTable::empty() const {
+    return deadlines.empty();
+}
+
+void TaskTable::reserve(size_t count) {
+    deadlines.reserve(count);
+    priorities.reserve(count);
+    completedWords.reserve((count + 63) / 64);
+    tags.reserve(count);
+    ids.reserve(count);
+    text.reserve(count);
+}
+
+void TaskTable::clear() {
+    deadlines.clear();
+    priorities.clear();
+    completedWords.clear();
+    tags.clear();
+    ids.clear();
+    text.clear();
+    arena.clear();
+    liveTextBytes = 0;
+}
+
+// Copy-on-write for one field: an unchanged string keeps its bytes, a changed one is appended
+std::string_view TaskTable::replaceText(std::string_view current, std::string_view replacement) {
+    if (current == replacement) return current;
+    liveTextBytes += replacement.size();
+    liveTextBytes -= current.size();
+    return arena.append(replacement);
+}
+
+void TaskTable::dropText(const ColdText& row) {
+    liveTextBytes -= row.title.size() + row.description.size() + row.tag.size();
+}
+
+// Once more than half the arena is garbage from edits and removals, the live strings are
+// copied into a fresh one; tables sharing the old chunks keep them alive until they let go
+void TaskTable::compactTextIfSparse() {
+    const size_t minimumGarbage = size_t(1) << 20;
+    if (arena.usedBytes() < 2 * liveTextBytes + minimumGarbage) return;
+
+    StringArena compacted;
+    compacted.reserve(liveTextBytes);
+    for (size_t index = 0; index < text.size(); ++index) {
+        ColdText& row = text.writable(index);
+        row.title = compacted.append(row.title);
+        row.description = compacted.append(row.description);
+        row.tag = compacted.append(row.tag);
+    }
+    arena = std::move(compacted);
+}
+
+void TaskTable::push_back(const Task& task) {
+    push_back(task.getTitle(), task.getDescription(), task.getDeadline(), task.getPriority(),
+        task.getTag(), task.getCompleted(), task.getId());
+}
+
+void TaskTable::push_back(std::string_view title, std::string_view description, std::chrono::system_clock::time_point deadline,
+    Priority priority, std::string_view tag, bool completed, TaskId id) {
+    size_t index = size();
+    deadlines.push_back(toTicks(deadline));
+    priorities.push_back(static_cast<uint8_t>(priority));
+    if (index % 64 == 0) completedWords.push_back(0);
+    tags.push_back(noTag);
+    ids.push_back(id);
+    text.push_back(ColdText{ arena.append(title), arena.append(description), arena.append(tag) });
+    liveTextBytes += title.size() + description.size() + tag.size();
+    setCompleted(index, completed);
+}
+
+void TaskTable::assign(size_t index, const Task& task) {
+    deadlines.writable(index) = toTicks(task.getDeadline());
+    priorities.writable(index) = static_cast<uint8_t>(task.getPriority());
+    tags.writable(index) = noTag;
+    ids.writable(index) = task.getId();
+    ColdText& row = text.writable(index);
+    row.title = replaceText(row.title, task.getTitle());
+    row.description = replaceText(row.description, task.getDescription());
+    row.tag = replaceText(row.tag, task.getTag());
+    setCompleted(index, task.getCompleted());
+    compactTextIfSparse();
+}
+
+void TaskTable::moveLastTo(size_t index) {
+    size_t last = size() - 1;
+    if (index != last) {
+        deadlines.writable(index) = deadlines[last];
+        priorities.writable(index) = priorities[last];
+        tags.writable(index) = tags[last];
+        ids.writable(index) = ids[last];
+        std::swap(text.writable(index), text.writable(last)); // pop_back then drops the removed row's text
+        setCompleted(index, completed(last));
+    }
+    pop_back();
+}
+
+void TaskTable::pop_back() {
+    size_t last = size() - 1;
+    setCompleted(last, false); // keeps the bits past the end zero, so word-wise counts stay exact
+    deadlines.pop_back();
+    priorities.pop_back();
+    if (last % 64 == 0) completedWords.pop_back();
+    tags.pop_back();
+    ids.pop_back();
+    dropText(text.back());
+    text.pop_back();
+    compactTextIfSparse();
+}
+
+void TaskTable::setCompleted(size_t index, bool completed) {
+    uint64_t bit = uint64_t(1) << (index % 64);
+    uint64_t& word = completedWords.writable(index / 64);
+    word = completed ? word | bit : word & ~bit;
+}
+
+void TaskTable::setId(size_t index, TaskId id) {
+    ids.writable(index) = id;
+}
+
+void TaskTable::setTagId(size_t index, TagId tagId) {
+    tags.writable(index) = tagId;
+}
+
+TaskRef TaskTable::operator[](size_t index) const {
+    return TaskRef(*this, index);
+}
+
+TaskTable::iterator TaskTable::begin() const {
+    return iterator(this, 0);
+}
+
+TaskTable::iterator TaskTable::end() const {
+    return iterator(this, size());
+}
+
+const TaskTable::Column<int64_t>& TaskTable::deadlineColumn() const {
+    return deadlines;
+}
+
+const TaskTable::Column<uint8_t>& TaskTable::priorityColumn() const {
+    return priorities;
+}
+
+const ChunkedColumn<uint64_t, TaskTable::pageShift - 6>& TaskTable::completedBits() const {
+    return completedWords;
+}
+
+const TaskTable::Column<TagId>& TaskTable::tagColumn() const {
+    return tags;
+}
+
+const TaskTable::Column<TaskId>& TaskTable::idColumn() const {
+    return ids;
+}
+
+std::chrono::system_clock::time_point TaskTable::deadline(size_t index) const {
+    return std::chrono::system_clock::time_point(std::chrono::system_clock::duration(deadlines[index]));
+}
+
+Priority TaskTable::priority(size_t index) const {
+    return static_cast<Priority>(priorities[index]);
+}
+
+bool TaskTable::completed(size_t index) const {
+    return (completedWords[index / 64] >> (index % 64)) & 1;
+}
+
+TaskId TaskTable::id(size_t index) const {
+    return ids[index];
+}
+
+std::string_view TaskTable::title(size_t index) const {
+    return text[index].title;
+}
+
+std::string_view TaskTable::description(size_t index) const {
+    return text[index].description;
+}
+
+std::string_view TaskTable::tag(size_t index) const {
+    return text[index].tag;
+}
+
+void TaskTable::reserveText(size_t bytes) {
+    arena.reserve(bytes);
+}
+
+size_t TaskTable::textChunkCount() const {
+    return arena.chunkCount();
+}
+
+// One kernel call per page; page p of the deadlines and of the completion words cover the same rows
+size_t TaskTable::countIncompleteDue(int64_t from, int64_t to) const {
+    size_t total = 0;
+    for (size_t page = 0; page < deadlines.pageCount(); ++page) {
+        total += DeadlineKernels::countIncompleteDue(deadlines.page(page), completedWords.page(page),
+            deadlines.pageLength(page), from, to);
+    }
+    return total;
+}
+
+std::vector<uint64_t> TaskTable::selectIncompleteDue(int64_t from, int64_t to) const {
+    std::vector<uint64_t> selected(completedWords.size());
+    for (size_t page = 0; page < deadlines.pageCount(); ++page) {
+        DeadlineKernels::selectIncompleteDue(deadlines.page(page), completedWords.page(page),
+            deadlines.pageLength(page), from, to, selected.data() + page * (pageRows / 64));
+    }
+    return selected;
+}
+
+int64_t TaskTable::toTicks(std::chrono::system_clock::time_point moment) {
+    return static_cast<int64_t>(moment.time_since_epoch().count());
+}
\ No newline at end of file
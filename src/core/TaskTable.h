@@ -0,0 +1,156 @@
+#pragma once
+
+#include "Task.h"
+#include "StringArena.h"
+#include "TagDictionary.h"
+#include "ChunkedColumn.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class TaskTable;
+
+// Read-only handle to one row of a TaskTable, with the getters of Task (the strings come as
+// views into the table). It is only valid while the table is not mutated, like a reference
+// into a vector.
+class TaskRef {
+public:
+    TaskRef(const TaskTable& table, size_t index) : table(&table), index(index) {}
+
+    std::string_view getTitle() const;
+    std::string_view getDescription() const;
+    std::chrono::system_clock::time_point getDeadline() const;
+    Priority getPriority() const;
+    std::string_view getTag() const;
+    bool getCompleted() const;
+    TaskId getId() const;
+
+    // Copies the row out into a standalone Task
+    Task toTask() const;
+    void print() const;
+
+private:
+    const TaskTable* table;
+    size_t index;
+};
+
+void to_json(nlohmann::json& j, const TaskRef& task);
+
+// Column-wise task storage. The fields scans and sorts read (deadline, priority, completion,
+// tag id) live in packed arrays of their own, so a pass over one of them streams through
+// 1-8 bytes per task instead of a whole Task; titles, descriptions and tags as written are
+// kept apart in a cold store that only searches and rendering touch.
+// The tag column holds TagDictionary ids. The table does not intern tags itself: a row
+// starts out with noTag, and TaskManager stores the id when it indexes the row.
+// All string bytes live in a StringArena, so a table of a million tasks holds a dozen
+// large allocations rather than millions of small ones, and copying it (as snapshots do)
+// copies no text. Edits never overwrite bytes: a changed field is appended anew and the
+// old bytes stay behind for any copy still reading them, until the arena is compacted.
+// The columns are ChunkedColumns of pageRows rows, shared the same way: a copy costs a
+// pointer per page, and a later edit copies only the pages it writes to.
+class TaskTable {
+public:
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = TaskRef;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = TaskRef;
+
+        iterator(const TaskTable* table, size_t index) : table(table), index(index) {}
+
+        TaskRef operator*() const { return TaskRef(*table, index); }
+        iterator& operator++() { ++index; return *this; }
+        iterator operator++(int) { iterator copy = *this; ++index; return copy; }
+        bool operator==(const iterator& other) const { return index == other.index; }
+        bool operator!=(const iterator& other) const { return index != other.index; }
+
+    private:
+        const TaskTable* table;
+        size_t index;
+    };
+
+    static constexpr TagId noTag = UINT32_MAX;
+    static constexpr size_t pageShift = 10;
+    static constexpr size_t pageRows = size_t(1) << pageShift; // a multiple of 64, so pages hold whole completion words
+
+    size_t size() const;
+    bool empty() const;
+    void reserve(size_t count);
+    void clear();
+
+    void push_back(const Task& task);
+    // Appends a row whose strings are copied in, so they can be views into a parser's buffers
+    void push_back(std::string_view title, std::string_view description, std::chrono::system_clock::time_point deadline,
+        Priority priority, std::string_view tag, bool completed, TaskId id);
+    // Overwrites the row at index with task; only the strings that changed are copied.
+    // Its tag id is reset to noTag until the row is indexed again.
+    void assign(size_t index, const Task& task);
+    // Moves the last row into index and drops the last row (swap-and-pop)
+    void moveLastTo(size_t index);
+    void pop_back();
+
+    void setCompleted(size_t index, bool completed);
+    void setId(size_t index, TaskId id);
+    void setTagId(size_t index, TagId tagId);
+
+    TaskRef operator[](size_t index) const;
+    iterator begin() const;
+    iterator end() const;
+
+    template <typename T>
+    using Column = ChunkedColumn<T, pageShift>;
+
+    // Hot columns, one entry (or bit) per task
+    const Column<int64_t>& deadlineColumn() const;  // system_clock ticks since the epoch
+    const Column<uint8_t>& priorityColumn() const;
+    const ChunkedColumn<uint64_t, pageShift - 6>& completedBits() const;  // bit i of word i / 64 is task i
+    const Column<TagId>& tagColumn() const;         // TagDictionary ids
+    const Column<TaskId>& idColumn() const;
+
+    std::chrono::system_clock::time_point deadline(size_t index) const;
+    Priority priority(size_t index) const;
+    bool completed(size_t index) const;
+    TaskId id(size_t index) const;
+    std::string_view title(size_t index) const;
+    std::string_view description(size_t index) const;
+    std::string_view tag(size_t index) const;
+
+    // Room for this many more title, description and tag bytes in one arena allocation
+    void reserveText(size_t bytes);
+    size_t textChunkCount() const;
+
+    // Tasks with from <= deadline <= to (in ticks) that are not completed, found by one
+    // vectorized pass over the deadline column and the completion bits (see DeadlineKernels)
+    size_t countIncompleteDue(int64_t from, int64_t to) const;
+    // The same tasks as a bitmap: bit i of word i / 64 is set for each of them
+    std::vector<uint64_t> selectIncompleteDue(int64_t from, int64_t to) const;
+
+    static int64_t toTicks(std::chrono::system_clock::time_point moment);
+
+private:
+    struct ColdText {
+        std::string_view title;
+        std::string_view description;
+        std::string_view tag;
+    };
+
+    std::string_view replaceText(std::string_view current, std::string_view replacement);
+    void dropText(const ColdText& row);
+    void compactTextIfSparse();
+
+    Column<int64_t> deadlines;
+    Column<uint8_t> priorities;
+    ChunkedColumn<uint64_t, pageShift - 6> completedWords; // one page per page of rows
+    Column<TagId> tags;
+    Column<TaskId> ids;
+    Column<ColdText> text;
+
+    StringArena arena;
+    size_t liveTextBytes = 0; // strings still referenced; the rest of the arena is garbage
+};
\ No newline at end of file
@@ -0,0 +1,36 @@
+#include "TaskView.h"
+
+// Index-based result view over a TaskManager's tasks
+
+TaskView::TaskView(const TaskTable* tasks, std::vector<size_t> indices, bool identity)
+    : tasks(tasks), indices(std::move(indices)), identity(identity) {
+}
+
+TaskView TaskView::all(const TaskTable& tasks) {
+    return TaskView(&tasks, {}, true);
+}
+
+TaskView TaskView::of(const TaskTable& tasks, std::vector<size_t> indices) {
+    return TaskView(&tasks, std::move(indices), false);
+}
+
+size_t TaskView::size() const {
+    return identity ? tasks->size() : indices.size();
+}
+
+bool TaskView::empty() const {
+    return size() == 0;
+}
+
+TaskEntry TaskView::operator[](size_t position) const {
+    size_t index = identity ? position : indices[position];
+    return TaskEntry{ index, (*tasks)[index] };
+}
+
+TaskView::iterator TaskView::begin() const {
+    return iterator(this, 0);
+}
+
+TaskView::iterator TaskView::end() const {
+    return iterator(this, size());
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "TaskTable.h"
+#include <vector>
+#include <iterator>
+#include <cstddef>
+
+// One row of a query result: a task and its position in the manager's list
+struct TaskEntry {
+    size_t index;
+    TaskRef task;
+};
+
+// Lightweight query result: a list of positions into the manager's tasks.
+// Tasks are never copied; rows are resolved on access. The view is only valid
+// until the next mutation of the TaskManager that produced it.
+class TaskView {
+public:
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = TaskEntry;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = TaskEntry;
+
+        iterator(const TaskView* view, size_t position) : view(view), position(position) {}
+
+        TaskEntry operator*() const { return (*view)[position]; }
+        iterator& operator++() { ++position; return *this; }
+        iterator operator++(int) { iterator copy = *this; ++position; return copy; }
+        bool operator==(const iterator& other) const { return position == other.position; }
+        bool operator!=(const iterator& other) const { return position != other.position; }
+
+    private:
+        const TaskView* view;
+        size_t position;
+    };
+
+    // Every task, in list order
+    static TaskView all(const TaskTable& tasks);
+    // The given positions, in that order (the view takes ownership of them)
+    static TaskView of(const TaskTable& tasks, std::vector<size_t> indices);
+
+    size_t size() const;
+    bool empty() const;
+    TaskEntry operator[](size_t position) const;
+
+    iterator begin() const;
+    iterator end() const;
+
+private:
+    TaskView(const TaskTable* tasks, std::vector<size_t> indices, bool identity);
+
+    const TaskTable* tasks;
+    std::vector<size_t> indices;
+    bool identity; // view over all tasks, no index list at all
+};
\ No newline at end of file
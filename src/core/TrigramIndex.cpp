@@ -0,0 +1,104 @@
+#include "TrigramIndex.h"
+#include <algorithm>
+#include <cctype>
+
+// Maintains trigram posting lists so keyword search only inspects likely matches
+
+static uint32_t packTrigram(unsigned char a, unsigned char b, unsigned char c) {
+    return (static_cast<uint32_t>(std::tolower(a)) << 16) |
+        (static_cast<uint32_t>(std::tolower(b)) << 8) |
+        static_cast<uint32_t>(std::tolower(c));
+}
+
+// Appends the trigrams of a single field (trigrams never span two fields)
+void TrigramIndex::collect(std::string_view text, std::vector<uint32_t>& out) {
+    for (size_t i = 0; i + 2 < text.size(); ++i) {
+        out.push_back(packTrigram(text[i], text[i + 1], text[i + 2]));
+    }
+}
+
+// Returns the distinct trigrams of a task's title and description
+std::vector<uint32_t> TrigramIndex::trigramsOf(SearchText task) {
+    std::vector<uint32_t> grams;
+    collect(task.title, grams);
+    collect(task.description, grams);
+    std::sort(grams.begin(), grams.end());
+    grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+    return grams;
+}
+
+void TrigramIndex::insertPosting(uint32_t gram, size_t index) {
+    postings[gram].insert(index);
+}
+
+void TrigramIndex::erasePosting(uint32_t gram, size_t index) {
+    auto found = postings.find(gram);
+    if (found == postings.end()) return;
+    found->second.erase(index);
+    if (found->second.empty()) postings.erase(found);
+}
+
+void TrigramIndex::add(size_t index, SearchText task) {
+    for (uint32_t gram : trigramsOf(task)) insertPosting(gram, index);
+}
+
+void TrigramIndex::remove(size_t index, SearchText task) {
+    for (uint32_t gram : trigramsOf(task)) erasePosting(gram, index);
+}
+
+// Trigrams both versions share keep their entry
+void TrigramIndex::update(size_t index, SearchText before, SearchText after) {
+    std::vector<uint32_t> removed = trigramsOf(before);
+    std::vector<uint32_t> added = trigramsOf(after);
+    size_t i = 0, j = 0;
+    while (i < removed.size() || j < added.size()) {
+        if (j == added.size() || (i < removed.size() && removed[i] < added[j])) erasePosting(removed[i++], index);
+        else if (i == removed.size() || added[j] < removed[i]) insertPosting(added[j++], index);
+        else {
+            ++i;
+            ++j;
+        }
+    }
+}
+
+void TrigramIndex::replace(size_t to, SearchText removed, size_t from, SearchText moved) {
+    std::vector<uint32_t> dropped = trigramsOf(removed);
+    std::vector<uint32_t> kept = trigramsOf(moved);
+    size_t i = 0, j = 0;
+    while (i < dropped.size() || j < kept.size()) {
+        if (j == kept.size() || (i < dropped.size() && dropped[i] < kept[j])) {
+            erasePosting(dropped[i++], to);
+        }
+        else if (i == dropped.size() || kept[j] < dropped[i]) {
+            erasePosting(kept[j], from);
+            insertPosting(kept[j++], to);
+        }
+        else {
+            erasePosting(kept[j++], from); // `to` is already listed for this trigram
+            ++i;
+        }
+    }
+}
+
+void TrigramIndex::clear() {
+    postings.clear();
+}
+
+std::optional<std::vector<size_t>> TrigramIndex::candidates(const std::string& loweredKeyword) const {
+    if (loweredKeyword.size() < 3) return std::nullopt;
+
+    std::vector<uint32_t> grams;
+    collect(loweredKeyword, grams);
+    std::sort(grams.begin(), grams.end());
+    grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+
+    std::vector<const PostingList*> lists;
+    lists.reserve(grams.size());
+    for (uint32_t gram : grams) {
+        auto found = postings.find(gram);
+        if (found == postings.end()) return std::vector<size_t>{}; // some trigram occurs nowhere
+        lists.push_back(&found->second);
+    }
+
+    return PostingList::intersect(std::move(lists));
+}
\ No newline at end of file
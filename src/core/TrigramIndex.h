@@ -0,0 +1,41 @@
+#pragma once
+
+#include "PostingList.h"
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// The fields of a task the index covers
+struct SearchText {
+    std::string_view title;
+    std::string_view description;
+};
+
+// Inverted index of lowercased 3-byte substrings of task titles and descriptions.
+// Each posting list holds task indices; updating one costs the same at any list length.
+class TrigramIndex {
+public:
+    void add(size_t index, SearchText task);
+    void remove(size_t index, SearchText task);
+    // Re-indexes the task at index after an edit; only trigrams that changed are touched
+    void update(size_t index, SearchText before, SearchText after);
+    // The task at `from` moves into `to`, replacing `removed` (which is dropped from the index).
+    // Trigrams both tasks share keep their entry for `to`.
+    void replace(size_t to, SearchText removed, size_t from, SearchText moved);
+    void clear();
+
+    // Indices of tasks that contain every trigram of the (already lowercased) keyword.
+    // Returns nullopt if the keyword is too short to be answered from the index.
+    std::optional<std::vector<size_t>> candidates(const std::string& loweredKeyword) const;
+
+private:
+    static std::vector<uint32_t> trigramsOf(SearchText task);
+    static void collect(std::string_view text, std::vector<uint32_t>& out);
+    void insertPosting(uint32_t gram, size_t index);
+    void erasePosting(uint32_t gram, size_t index);
+
+    std::unordered_map<uint32_t, PostingList> postings;
+};
\ No newline at end of file
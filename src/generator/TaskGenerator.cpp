@@ -0,0 +1,151 @@
+#include "TaskGenerator.h"
+#include "DateTimeUtils.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+    // None of the words needs JSON escaping, so they are copied into the output as they are
+    const char* const englishWords[] = { "review", "quarterly", "report", "deploy", "invoice", "meeting", "draft",
+        "budget", "client", "update", "backup", "release", "design", "call", "plan", "fix", "groceries", "dentist",
+        "refactor", "migrate", "schedule", "prepare", "send", "slides", "contract", "server", "renew", "insurance",
+        "book", "flight", "hotel", "team", "sync", "notes", "feedback", "onboarding", "taxes", "order", "parts", "car" };
+    const char* const unicodeWords[] = {
+        "звіт", "зустріч", "бюджет", "клієнт", "оновлення", "реліз", "дзвінок", "план", "виправити", "купити",
+        "лікар", "подорож", "квиток", "договір", "нотатки", "щотижневий",
+        "Besprechung", "Änderung", "Prüfung", "Übersicht", "Größe", "Straße", "Bestellung", "Rückmeldung",
+        "会議", "報告書", "予算", "確認", "締め切り", "資料", "出張", "更新",
+        "🚀", "✅", "📌", "🔥", "📅", "☕" };
+    const char* const knownTags[] = { "work", "home", "personal", "finance", "health", "travel", "shopping",
+        "family", "study", "urgent", "errands", "project", "car", "garden", "робота", "дім" };
+
+    const size_t englishCount = sizeof(englishWords) / sizeof(englishWords[0]);
+    const size_t unicodeCount = sizeof(unicodeWords) / sizeof(unicodeWords[0]);
+    const size_t knownTagCount = sizeof(knownTags) / sizeof(knownTags[0]);
+    const double pi = 3.14159265358979323846;
+    const size_t flushBytes = 1 << 20;
+
+    std::vector<double> cumulativeOf(const std::vector<double>& weights) {
+        std::vector<double> cumulative;
+        double total = 0;
+        for (double weight : weights) {
+            if (weight < 0 || !std::isfinite(weight)) throw std::runtime_error("Weights must be non-negative");
+            total += weight;
+            cumulative.push_back(total);
+        }
+        if (total <= 0) throw std::runtime_error("At least one weight must be positive");
+        return cumulative;
+    }
+}
+
+TaskGenerator::TaskGenerator(const GeneratorOptions& options)
+    : options(options), engine(options.seed) {
+    if (options.tagCount == 0) throw std::runtime_error("--tags must be at least 1");
+    if (options.titleWordsMin == 0 || options.titleWordsMin > options.titleWordsMax
+        || options.descriptionWordsMin > options.descriptionWordsMax) {
+        throw std::runtime_error("Word ranges must be min-max with min <= max (titles need at least one word)");
+    }
+    if (options.completedRatio < 0 || options.completedRatio > 1 || options.unicodeRatio < 0 || options.unicodeRatio > 1) {
+        throw std::runtime_error("Ratios must be between 0 and 1");
+    }
+    if (options.deadlineSpreadDays < 0) throw std::runtime_error("--deadline-spread must not be negative");
+
+    std::vector<double> tagWeights;
+    for (size_t i = 0; i < options.tagCount; ++i) {
+        tags.push_back(i < knownTagCount ? knownTags[i] : "tag" + std::to_string(i));
+        tagWeights.push_back(1.0 / std::pow(static_cast<double>(i + 1), options.tagSkew));
+    }
+    tagCumulative = cumulativeOf(tagWeights);
+    priorityCumulative = cumulativeOf({ options.priorityWeights[0], options.priorityWeights[1], options.priorityWeights[2] });
+}
+
+double TaskGenerator::uniform() {
+    return static_cast<double>(engine() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+size_t TaskGenerator::below(size_t bound) {
+    return static_cast<size_t>(engine() % bound);
+}
+
+// Box-Muller; the second value is dropped so every draw takes the same two engine outputs
+double TaskGenerator::normal() {
+    double u1 = 1.0 - uniform(); // (0, 1], keeps log() finite
+    double u2 = uniform();
+    return std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * pi * u2);
+}
+
+size_t TaskGenerator::pick(const std::vector<double>& cumulative) {
+    double target = uniform() * cumulative.back();
+    auto it = std::upper_bound(cumulative.begin(), cumulative.end(), target);
+    return std::min(static_cast<size_t>(it - cumulative.begin()), cumulative.size() - 1);
+}
+
+void TaskGenerator::appendWords(std::string& out, size_t minWords, size_t maxWords) {
+    size_t count = minWords + below(maxWords - minWords + 1);
+    for (size_t i = 0; i < count; ++i) {
+        if (i > 0) out += ' ';
+        if (uniform() < options.unicodeRatio) out += unicodeWords[below(unicodeCount)];
+        else out += englishWords[below(englishCount)];
+    }
+}
+
+// Same field order and indentation as json::dump(4), which sorts the keys
+void TaskGenerator::appendTask(std::string& out, uint64_t index) {
+    using namespace std::chrono;
+    int64_t offsetMinutes = std::llround((options.deadlineOffsetDays + normal() * options.deadlineSpreadDays) * 24 * 60);
+    auto deadline = time_point_cast<minutes>(options.now) + minutes(offsetMinutes);
+
+    out += "    {\n        \"completed\": ";
+    out += uniform() < options.completedRatio ? "true" : "false";
+    out += ",\n        \"deadline\": ";
+    if (options.epochDeadlines) {
+        out += std::to_string(DateTimeUtils::toEpochSeconds(deadline));
+    }
+    else {
+        out += '"';
+        DateTimeUtils::appendTimePoint(out, deadline);
+        out += '"';
+    }
+    out += ",\n        \"description\": \"";
+    appendWords(out, options.descriptionWordsMin, options.descriptionWordsMax);
+    out += "\",\n        \"id\": ";
+    out += std::to_string(index + 1); // what a fresh TaskManager hands out in list order
+    out += ",\n        \"priority\": ";
+    out += static_cast<char>('0' + pick(priorityCumulative));
+    out += ",\n        \"tag\": \"";
+    out += tags[pick(tagCumulative)];
+    out += "\",\n        \"title\": \"";
+    appendWords(out, options.titleWordsMin, options.titleWordsMax);
+    // The number keeps titles distinct, as real lists mostly are
+    out += " #";
+    out += std::to_string(index + 1);
+    out += "\"\n    }";
+}
+
+uint64_t TaskGenerator::write(std::ostream& out) {
+    uint64_t written = 0;
+    std::string buffer;
+    buffer.reserve(flushBytes + 4096);
+    auto flush = [&]() {
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        if (!out) throw std::runtime_error("Failed to write generated tasks");
+        written += buffer.size();
+        buffer.clear();
+    };
+
+    if (options.count == 0) {
+        buffer += "[]";
+    }
+    else {
+        buffer += "[\n";
+        for (uint64_t i = 0; i < options.count; ++i) {
+            if (i > 0) buffer += ",\n";
+            appendTask(buffer, i);
+            if (buffer.size() >= flushBytes) flush();
+        }
+        buffer += "\n]";
+    }
+    flush();
+    out.flush();
+    return written;
+}
\ No newline at end of file
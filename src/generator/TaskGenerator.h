@@ -0,0 +1,50 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+struct GeneratorOptions {
+    uint64_t count = 1000;
+    uint64_t seed = 1;
+    std::chrono::system_clock::time_point now = std::chrono::system_clock::now(); // deadlines are spread around it
+
+    size_t tagCount = 20;          // distinct tags
+    double tagSkew = 1.0;          // Zipf exponent of tag popularity; 0 makes every tag equally likely
+    double deadlineOffsetDays = 0; // mean deadline relative to now (negative: mostly overdue)
+    double deadlineSpreadDays = 14; // standard deviation of deadlines around that mean
+    double priorityWeights[3] = { 50, 35, 15 }; // low, medium, high
+    double completedRatio = 0.3;
+    size_t titleWordsMin = 2, titleWordsMax = 6;
+    size_t descriptionWordsMin = 5, descriptionWordsMax = 30;
+    double unicodeRatio = 0.2;     // share of words taken from the Ukrainian, German, Japanese and emoji lists
+    bool epochDeadlines = false;   // write deadlines as epoch seconds, as `convert` can
+};
+
+// Writes synthetic tasks in the layout JsonStorage saves, one task at a time through a small
+// buffer, so any count takes constant memory. Sampling uses only mt19937_64 (whose output the
+// standard fixes) plus arithmetic done here, so a seed and options reproduce the same file.
+class TaskGenerator {
+public:
+    explicit TaskGenerator(const GeneratorOptions& options);
+
+    // Returns the number of bytes written; throws std::runtime_error if the stream fails
+    uint64_t write(std::ostream& out);
+
+private:
+    double uniform();                 // [0, 1)
+    size_t below(size_t bound);
+    double normal();
+    size_t pick(const std::vector<double>& cumulative);
+    void appendWords(std::string& out, size_t minWords, size_t maxWords);
+    void appendTask(std::string& out, uint64_t index);
+
+    GeneratorOptions options;
+    std::mt19937_64 engine;
+    std::vector<std::string> tags;
+    std::vector<double> tagCumulative;
+    std::vector<double> priorityCumulative;
+};
\ No newline at end of file
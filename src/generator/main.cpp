@@ -0,0 +1,109 @@
+#include "TaskGenerator.h"
+#include "DateTimeUtils.h"
+#include <chrono>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+static const char* const usage =
+    "Usage: task_generator [--count 1000] [--output tasks.json|-] [--seed 1] [--now \"YYYY-MM-DD HH:MM\"]\n"
+    "                      [--tags 20] [--tag-skew 1.0] [--deadline-offset 0] [--deadline-spread 14]\n"
+    "                      [--priorities 50,35,15] [--completed 0.3] [--title-words 2-6]\n"
+    "                      [--description-words 5-30] [--unicode 0.2] [--epoch-deadlines]\n\n"
+    "Writes synthetic tasks in the format task_manager loads, streaming them so any count fits in\n"
+    "constant memory. Counts take k/m/g suffixes. Deadlines are normally distributed around --now\n"
+    "(offset and spread in days); tag popularity follows a Zipf law with the given exponent.\n"
+    "The same seed, options, --now and time zone always produce the same file.\n";
+
+static uint64_t parseCount(const std::string& text) {
+    size_t consumed = 0;
+    uint64_t value = std::stoull(text, &consumed);
+    std::string suffix = text.substr(consumed);
+    if (suffix == "k" || suffix == "K") return value * 1000;
+    if (suffix == "m" || suffix == "M") return value * 1000 * 1000;
+    if (suffix == "g" || suffix == "G") return value * 1000 * 1000 * 1000;
+    if (!suffix.empty()) throw std::runtime_error("Bad count: " + text);
+    return value;
+}
+
+static void parseRange(const std::string& text, size_t& min, size_t& max) {
+    size_t dash = text.find('-');
+    if (dash == std::string::npos) {
+        min = max = std::stoul(text);
+        return;
+    }
+    min = std::stoul(text.substr(0, dash));
+    max = std::stoul(text.substr(dash + 1));
+}
+
+static void parseWeights(const std::string& text, double (&weights)[3]) {
+    size_t start = 0;
+    for (int i = 0; i < 3; ++i) {
+        size_t comma = text.find(',', start);
+        if ((i < 2) == (comma == std::string::npos)) throw std::runtime_error("--priorities needs three weights: low,medium,high");
+        weights[i] = std::stod(text.substr(start, comma == std::string::npos ? std::string::npos : comma - start));
+        start = comma + 1;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    GeneratorOptions options;
+    std::string output = "tasks.json";
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            auto value = [&]() -> std::string {
+                if (i + 1 >= argc) throw std::runtime_error(arg + " needs a value");
+                return argv[++i];
+            };
+
+            if (arg == "--count") options.count = parseCount(value());
+            else if (arg == "--output" || arg == "-o") output = value();
+            else if (arg == "--seed") options.seed = std::stoull(value());
+            else if (arg == "--now") options.now = DateTimeUtils::stringToTimePoint(value());
+            else if (arg == "--tags") options.tagCount = std::stoul(value());
+            else if (arg == "--tag-skew") options.tagSkew = std::stod(value());
+            else if (arg == "--deadline-offset") options.deadlineOffsetDays = std::stod(value());
+            else if (arg == "--deadline-spread") options.deadlineSpreadDays = std::stod(value());
+            else if (arg == "--priorities") parseWeights(value(), options.priorityWeights);
+            else if (arg == "--completed") options.completedRatio = std::stod(value());
+            else if (arg == "--title-words") parseRange(value(), options.titleWordsMin, options.titleWordsMax);
+            else if (arg == "--description-words") parseRange(value(), options.descriptionWordsMin, options.descriptionWordsMax);
+            else if (arg == "--unicode") options.unicodeRatio = std::stod(value());
+            else if (arg == "--epoch-deadlines") options.epochDeadlines = true;
+            else if (arg == "--help" || arg == "-h") {
+                std::cout << usage;
+                return 0;
+            }
+            else throw std::runtime_error("Unknown option: " + arg);
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << "\n\n" << usage;
+        return 1;
+    }
+
+    try {
+        TaskGenerator generator(options);
+        auto started = std::chrono::steady_clock::now();
+        uint64_t bytes = 0;
+        if (output == "-") {
+            std::ios::sync_with_stdio(false);
+            bytes = generator.write(std::cout);
+        }
+        else {
+            std::ofstream file(output, std::ios::binary | std::ios::trunc);
+            if (!file) throw std::runtime_error("Cannot open " + output + " for writing");
+            bytes = generator.write(file);
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        std::cerr << "Generated " << options.count << " tasks (" << bytes / (1024 * 1024) << " MiB) in "
+            << seconds << " s\n";
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Generation failed: " << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
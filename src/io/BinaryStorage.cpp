@@ -0,0 +1,374 @@
+#include "BinaryStorage.h"
+#include <fstream>
+#include <cstring>
+#include <cstddef>
+#include <stdexcept>
+#include <filesystem>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Binary snapshot backend: fixed-width columns plus a string heap, read through mmap
+
+namespace {
+    const char snapshotMagic[8] = { 'T', 'M', 'S', 'N', 'A', 'P', '\0', '\0' };
+    constexpr uint32_t byteOrderMark = 0x01020304;
+
+    uint64_t alignUp(uint64_t offset) {
+        return (offset + 7) & ~uint64_t(7);
+    }
+
+    int64_t toEpochSeconds(std::chrono::system_clock::time_point tp) {
+        return std::chrono::duration_cast<std::chrono::seconds>(tp.time_since_epoch()).count();
+    }
+
+    void writePadding(std::ofstream& out, uint64_t from, uint64_t to) {
+        static const char zeros[8] = {};
+        out.write(zeros, static_cast<std::streamsize>(to - from));
+    }
+}
+
+MappedSnapshot::MappedSnapshot(const std::string& filename) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) throw std::runtime_error("Cannot open snapshot: " + filename);
+    fileHandle = file;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        throw std::runtime_error("Cannot stat snapshot: " + filename);
+    }
+    length = static_cast<size_t>(fileSize.QuadPart);
+
+    if (length > 0) {
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) {
+            CloseHandle(file);
+            throw std::runtime_error("Cannot map snapshot: " + filename);
+        }
+        mappingHandle = mapping;
+        data = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        if (!data) {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            throw std::runtime_error("Cannot map snapshot: " + filename);
+        }
+    }
+#else
+    fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("Cannot open snapshot: " + filename);
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Cannot stat snapshot: " + filename);
+    }
+    length = static_cast<size_t>(st.st_size);
+
+    if (length > 0) {
+        void* mapped = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) {
+            ::close(fd);
+            throw std::runtime_error("Cannot map snapshot: " + filename);
+        }
+        data = static_cast<const unsigned char*>(mapped);
+    }
+#endif
+
+    // Validate the header and that every column lies inside the file
+    try {
+        if (length < sizeof(SnapshotHeader)) throw std::runtime_error("Snapshot is truncated: " + filename);
+        header = reinterpret_cast<const SnapshotHeader*>(data);
+
+        if (std::memcmp(header->magic, snapshotMagic, sizeof(snapshotMagic)) != 0)
+            throw std::runtime_error("Not a task snapshot: " + filename);
+        if (header->byteOrderMark != byteOrderMark)
+            throw std::runtime_error("Snapshot was written with a different byte order: " + filename);
+        if (header->version != BinaryStorage::formatVersion)
+            throw std::runtime_error("Unsupported snapshot version " + std::to_string(header->version));
+
+        uint64_t count = header->count;
+        auto fits = [&](uint64_t offset, uint64_t bytes) {
+            return offset <= length && bytes <= length - offset;
+        };
+        if (count > length ||
+            !fits(header->deadlinesOffset, count * sizeof(int64_t)) ||
+            !fits(header->prioritiesOffset, count) ||
+            !fits(header->completedOffset, count) ||
+            !fits(header->stringOffsetsOffset, (3 * count + 1) * sizeof(uint64_t)) ||
+            !fits(header->heapOffset, header->heapSize) ||
+            !fits(header->idsOffset, count * sizeof(uint64_t)) ||
+            header->deadlinesOffset % 8 != 0 || header->stringOffsetsOffset % 8 != 0 || header->idsOffset % 8 != 0) {
+            throw std::runtime_error("Snapshot is corrupt: " + filename);
+        }
+        if (header->idStateOffset != 0) {
+            if (header->idStateOffset % 8 != 0 || !fits(header->idStateOffset, 2 * sizeof(uint64_t)))
+                throw std::runtime_error("Snapshot is corrupt: " + filename);
+            idStateWords = reinterpret_cast<const uint64_t*>(data + header->idStateOffset);
+            uint64_t freeCount = idStateWords[1];
+            if (idStateWords[0] > UINT32_MAX || freeCount > length ||
+                !fits(header->idStateOffset + 2 * sizeof(uint64_t), freeCount * sizeof(uint64_t)))
+                throw std::runtime_error("Snapshot is corrupt: " + filename);
+        }
+        for (uint64_t orderOffset : { header->deadlineOrderOffset, header->priorityOrderOffset }) {
+            if (orderOffset != 0 && (orderOffset % 4 != 0 || !fits(orderOffset, count * sizeof(uint32_t))))
+                throw std::runtime_error("Snapshot is corrupt: " + filename);
+        }
+
+        deadlines = reinterpret_cast<const int64_t*>(data + header->deadlinesOffset);
+        priorities = data + header->prioritiesOffset;
+        completedFlags = data + header->completedOffset;
+        stringOffsets = reinterpret_cast<const uint64_t*>(data + header->stringOffsetsOffset);
+        heap = reinterpret_cast<const char*>(data + header->heapOffset);
+        ids = reinterpret_cast<const uint64_t*>(data + header->idsOffset);
+        if (header->deadlineOrderOffset) deadlineRows = reinterpret_cast<const uint32_t*>(data + header->deadlineOrderOffset);
+        if (header->priorityOrderOffset) priorityRows = reinterpret_cast<const uint32_t*>(data + header->priorityOrderOffset);
+    }
+    catch (...) {
+        release();
+        throw;
+    }
+}
+
+MappedSnapshot::~MappedSnapshot() {
+    release();
+}
+
+// Unmaps the file and closes its handles
+void MappedSnapshot::release() {
+#ifdef _WIN32
+    if (data) UnmapViewOfFile(data);
+    if (mappingHandle) CloseHandle(mappingHandle);
+    if (fileHandle) CloseHandle(fileHandle);
+    mappingHandle = fileHandle = nullptr;
+#else
+    if (data) ::munmap(const_cast<unsigned char*>(data), length);
+    if (fd >= 0) ::close(fd);
+    fd = -1;
+#endif
+    data = nullptr;
+}
+
+size_t MappedSnapshot::size() const {
+    return static_cast<size_t>(header->count);
+}
+
+size_t MappedSnapshot::fileSize() const {
+    return length;
+}
+
+size_t MappedSnapshot::textSize() const {
+    return static_cast<size_t>(header->heapSize);
+}
+
+std::chrono::system_clock::time_point MappedSnapshot::deadline(size_t index) const {
+    return std::chrono::system_clock::time_point(std::chrono::seconds(deadlines[index]));
+}
+
+// Checked like the string offsets, since it comes from disk
+Priority MappedSnapshot::priority(size_t index) const {
+    uint8_t value = priorities[index];
+    if (value > static_cast<uint8_t>(Priority::High)) throw std::runtime_error("Snapshot priority column is corrupt");
+    return static_cast<Priority>(value);
+}
+
+bool MappedSnapshot::completed(size_t index) const {
+    return completedFlags[index] != 0;
+}
+
+std::string_view MappedSnapshot::title(size_t index) const {
+    return stringAt(3 * index);
+}
+
+std::string_view MappedSnapshot::description(size_t index) const {
+    return stringAt(3 * index + 1);
+}
+
+std::string_view MappedSnapshot::tag(size_t index) const {
+    return stringAt(3 * index + 2);
+}
+
+TaskId MappedSnapshot::id(size_t index) const {
+    return ids[index];
+}
+
+std::optional<SlotMapState> MappedSnapshot::idState() const {
+    if (!idStateWords) return std::nullopt;
+    SlotMapState state;
+    state.slotCount = static_cast<uint32_t>(idStateWords[0]);
+    state.freeIds.assign(idStateWords + 2, idStateWords + 2 + idStateWords[1]);
+    return state;
+}
+
+// Returns heap string number `slot`, checking the offsets since they come from disk
+std::string_view MappedSnapshot::stringAt(size_t slot) const {
+    uint64_t begin = stringOffsets[slot];
+    uint64_t end = stringOffsets[slot + 1];
+    if (begin > end || end > header->heapSize) throw std::runtime_error("Snapshot string table is corrupt");
+    return std::string_view(heap + begin, static_cast<size_t>(end - begin));
+}
+
+const uint32_t* MappedSnapshot::deadlineOrder() const {
+    return deadlineRows;
+}
+
+const uint32_t* MappedSnapshot::priorityOrder() const {
+    return priorityRows;
+}
+
+Task MappedSnapshot::toTask(size_t index) const {
+    Task task(std::string(title(index)), std::string(description(index)), deadline(index),
+        priority(index), std::string(tag(index)), completed(index));
+    task.setId(id(index));
+    return task;
+}
+
+// Writes all tasks as a version 4 snapshot, replacing the file atomically
+void BinaryStorage::saveToFile(const std::string& filename, const TaskTable& tasks, const TaskFileExtras* extras) {
+    const std::string tempPath = tempPathFor(filename);
+    std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+    if (!out) throw std::runtime_error("Cannot open file for writing: " + tempPath);
+
+    const uint64_t count = tasks.size();
+    uint64_t heapSize = 0;
+    for (const auto& task : tasks) {
+        heapSize += task.getTitle().size() + task.getDescription().size() + task.getTag().size();
+    }
+
+    SnapshotHeader header{};
+    std::memcpy(header.magic, snapshotMagic, sizeof(snapshotMagic));
+    header.version = formatVersion;
+    header.byteOrderMark = byteOrderMark;
+    header.count = count;
+    header.deadlinesOffset = alignUp(sizeof(SnapshotHeader));
+    header.prioritiesOffset = alignUp(header.deadlinesOffset + count * sizeof(int64_t));
+    header.completedOffset = alignUp(header.prioritiesOffset + count);
+    header.stringOffsetsOffset = alignUp(header.completedOffset + count);
+    header.heapOffset = alignUp(header.stringOffsetsOffset + (3 * count + 1) * sizeof(uint64_t));
+    header.heapSize = heapSize;
+    header.idsOffset = alignUp(header.heapOffset + heapSize);
+
+    // The optional sections follow the ids, each only if it was given
+    uint64_t end = header.idsOffset + count * sizeof(TaskId);
+    const SlotMapState* ids = extras && extras->ids ? &*extras->ids : nullptr;
+    if (ids) {
+        header.idStateOffset = end;
+        end += (2 + ids->freeIds.size()) * sizeof(uint64_t);
+    }
+    const bool hasOrders = extras && extras->deadlineOrder.size() == count && extras->priorityOrder.size() == count;
+    if (hasOrders) {
+        header.deadlineOrderOffset = end;
+        header.priorityOrderOffset = end + count * sizeof(uint32_t);
+    }
+
+    uint64_t position = 0;
+    auto writeRaw = [&](const void* bytes, uint64_t size) {
+        out.write(static_cast<const char*>(bytes), static_cast<std::streamsize>(size));
+        position += size;
+    };
+    auto padTo = [&](uint64_t offset) {
+        writePadding(out, position, offset);
+        position = offset;
+    };
+
+    writeRaw(&header, sizeof(header));
+
+    // The fixed-width columns come straight from the table's own columns
+    padTo(header.deadlinesOffset);
+    for (size_t i = 0; i < count; ++i) {
+        int64_t seconds = toEpochSeconds(tasks.deadline(i));
+        writeRaw(&seconds, sizeof(seconds));
+    }
+
+    padTo(header.prioritiesOffset);
+    const auto& priorities = tasks.priorityColumn();
+    for (size_t page = 0; page < priorities.pageCount(); ++page) {
+        writeRaw(priorities.page(page), priorities.pageLength(page));
+    }
+
+    padTo(header.completedOffset);
+    for (size_t i = 0; i < count; ++i) {
+        uint8_t completed = tasks.completed(i) ? 1 : 0;
+        writeRaw(&completed, 1);
+    }
+
+    padTo(header.stringOffsetsOffset);
+    uint64_t offset = 0;
+    writeRaw(&offset, sizeof(offset));
+    for (const auto& task : tasks) {
+        for (uint64_t length : { task.getTitle().size(), task.getDescription().size(), task.getTag().size() }) {
+            offset += length;
+            writeRaw(&offset, sizeof(offset));
+        }
+    }
+
+    padTo(header.heapOffset);
+    for (const auto& task : tasks) {
+        for (std::string_view text : { task.getTitle(), task.getDescription(), task.getTag() }) {
+            writeRaw(text.data(), text.size());
+        }
+    }
+
+    padTo(header.idsOffset);
+    const auto& taskIds = tasks.idColumn();
+    for (size_t page = 0; page < taskIds.pageCount(); ++page) {
+        writeRaw(taskIds.page(page), taskIds.pageLength(page) * sizeof(TaskId));
+    }
+
+    if (ids) {
+        const uint64_t words[2] = { ids->slotCount, ids->freeIds.size() };
+        writeRaw(words, sizeof(words));
+        writeRaw(ids->freeIds.data(), ids->freeIds.size() * sizeof(TaskId));
+    }
+    if (hasOrders) {
+        writeRaw(extras->deadlineOrder.data(), count * sizeof(uint32_t));
+        writeRaw(extras->priorityOrder.data(), count * sizeof(uint32_t));
+    }
+
+    out.close();
+    if (!out) throw std::runtime_error("Failed to write snapshot: " + tempPath);
+
+    publish(tempPath, filename);
+}
+
+// Maps the snapshot and copies it into a table, all text in one arena allocation
+// (returns empty list if file doesn't exist)
+TaskTable BinaryStorage::loadFromFile(const std::string& filename, TaskFileExtras* extras) {
+    auto started = std::chrono::steady_clock::now();
+    lastLoadStats = LoadStats{};
+
+    if (!std::filesystem::exists(filename)) return {};
+
+    MappedSnapshot snapshot(filename);
+    TaskTable tasks;
+    tasks.reserve(snapshot.size());
+    tasks.reserveText(snapshot.textSize());
+    for (size_t i = 0; i < snapshot.size(); ++i) {
+        tasks.push_back(snapshot.title(i), snapshot.description(i), snapshot.deadline(i), snapshot.priority(i),
+            snapshot.tag(i), snapshot.completed(i), snapshot.id(i));
+    }
+    if (extras) {
+        extras->ids = snapshot.idState();
+        if (snapshot.deadlineOrder()) extras->deadlineOrder.assign(snapshot.deadlineOrder(), snapshot.deadlineOrder() + snapshot.size());
+        if (snapshot.priorityOrder()) extras->priorityOrder.assign(snapshot.priorityOrder(), snapshot.priorityOrder() + snapshot.size());
+    }
+
+    lastLoadStats.tasks = tasks.size();
+    lastLoadStats.bytes = snapshot.fileSize();
+    lastLoadStats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    return tasks;
+}
+
+bool BinaryStorage::savesIndexOrders() const {
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include "TaskStorage.h"
+
+// On-disk layout of a binary snapshot (version 4, little-endian):
+//   header | int64 deadline[count] | uint8 priority[count] | uint8 completed[count]
+//   | uint64 stringOffsets[3 * count + 1] | string heap | uint64 id[count]
+//   | id state: uint64 slotCount, uint64 freeCount, uint64 freeId[freeCount]
+//   | uint32 deadlineOrder[count] | uint32 priorityOrder[count]
+// Strings are stored per task as title, description, tag; string k spans
+// heap[stringOffsets[k], stringOffsets[k + 1]). Every section starts 8-byte aligned but the
+// index orders, which are uint32 aligned.
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrderMark;
+    uint64_t count;
+    uint64_t deadlinesOffset;
+    uint64_t prioritiesOffset;
+    uint64_t completedOffset;
+    uint64_t stringOffsetsOffset;
+    uint64_t heapOffset;
+    uint64_t heapSize;
+    uint64_t idsOffset;
+    uint64_t idStateOffset; // 0 if saved without the id allocator state
+    uint64_t deadlineOrderOffset; // 0 if saved without the index orders
+    uint64_t priorityOrderOffset;
+};
+
+// Read-only memory mapping of a snapshot file. Opening only maps and validates
+// the header; the accessors read columns in place on demand.
+// BinaryStorage::loadFromFile still copies every row into a TaskTable, and TaskManager
+// still builds its ordered indexes node by node (from the saved orders, without sorting),
+// so a load costs O(tasks) allocations (see the storage.load_snap benchmark).
+class MappedSnapshot {
+public:
+    explicit MappedSnapshot(const std::string& filename);
+    ~MappedSnapshot();
+
+    MappedSnapshot(const MappedSnapshot&) = delete;
+    MappedSnapshot& operator=(const MappedSnapshot&) = delete;
+
+    size_t size() const;
+    size_t fileSize() const;
+    size_t textSize() const; // bytes of all titles, descriptions and tags
+
+    std::chrono::system_clock::time_point deadline(size_t index) const;
+    Priority priority(size_t index) const;
+    bool completed(size_t index) const;
+    std::string_view title(size_t index) const;
+    std::string_view description(size_t index) const;
+    std::string_view tag(size_t index) const;
+    TaskId id(size_t index) const;
+    std::optional<SlotMapState> idState() const;
+    // Row numbers in deadline and priority index order; null if the snapshot has none
+    const uint32_t* deadlineOrder() const;
+    const uint32_t* priorityOrder() const;
+
+    Task toTask(size_t index) const;
+
+private:
+    std::string_view stringAt(size_t slot) const;
+    void release();
+
+    const unsigned char* data = nullptr;
+    size_t length = 0;
+    const SnapshotHeader* header = nullptr;
+    const int64_t* deadlines = nullptr;
+    const uint8_t* priorities = nullptr;
+    const uint8_t* completedFlags = nullptr;
+    const uint64_t* stringOffsets = nullptr;
+    const char* heap = nullptr;
+    const uint64_t* ids = nullptr;
+    const uint64_t* idStateWords = nullptr;
+    const uint32_t* deadlineRows = nullptr;
+    const uint32_t* priorityRows = nullptr;
+
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#else
+    int fd = -1;
+#endif
+};
+
+class BinaryStorage : public TaskStorage {
+public:
+    static constexpr uint32_t formatVersion = 4;
+
+    void saveToFile(const std::string& filename, const TaskTable& tasks, const TaskFileExtras* extras = nullptr) override;
+    TaskTable loadFromFile(const std::string& filename, TaskFileExtras* extras = nullptr) override;
+    bool savesIndexOrders() const override;
+};
\ No newline at end of file
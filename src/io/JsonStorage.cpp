@@ -1,23 +1,233 @@
 #include "JsonStorage.h"
+#include "DateTimeUtils.h"
 #include <fstream>
+#include <filesystem>
+#include <chrono>
+#include <stdexcept>
 
 using json = nlohmann::json;
 
-// Saves a list of tasks to a JSON file (pretty-printed)
-void JsonStorage::saveToFile(const std::string& filename, const std::vector<Task>& tasks) {
-    std::ofstream outFile(filename);
-    if (!outFile) throw std::runtime_error("Cannot open file for writing: " + filename);
+namespace {
+    // Rough size of one pretty-printed task, used to pre-size the result vector
+    constexpr std::uintmax_t approxBytesPerTask = 160;
 
-    json j = tasks;           // calls to_json for each task
+    // Builds Tasks straight from SAX events: no intermediate DOM is ever materialized.
+    // Expects the layout written by saveToFile: {"ids": {"slots": n, "free": [...]}, "tasks": [...]}
+    // with flat task objects, or just the array of tasks (files saved without the id state).
+    class TaskSaxHandler : public json::json_sax_t {
+    public:
+        explicit TaskSaxHandler(TaskTable& out) : tasks(out) {}
+
+        size_t epochDeadlines = 0; // deadlines stored as integers rather than text
+        std::optional<SlotMapState> ids;
+
+        bool null() override { return skipOrFail("null"); }
+
+        bool boolean(bool val) override {
+            if (inTaskField() && currentKey == "completed") {
+                completed = val;
+                seen |= CompletedField;
+                return true;
+            }
+            return skipOrFail("boolean");
+        }
+
+        bool number_integer(number_integer_t val) override {
+            return number(static_cast<long long>(val));
+        }
+
+        bool number_unsigned(number_unsigned_t val) override {
+            if (inIdState()) return idStateNumber(val);
+            return number(static_cast<long long>(val));
+        }
+
+        bool number_float(number_float_t, const string_t&) override {
+            return skipOrFail("number");
+        }
+
+        bool string(string_t& val) override {
+            if (!inTaskField()) return skipOrFail("string");
+
+            // Copied into buffers reused for every task; the table copies them on into its arena
+            if (currentKey == "title") { title.assign(val); seen |= TitleField; }
+            else if (currentKey == "description") { description.assign(val); seen |= DescriptionField; }
+            else if (currentKey == "tag") { tag.assign(val); seen |= TagField; }
+            else if (currentKey == "deadline") {
+                deadline = DateTimeUtils::stringToTimePoint(val);
+                seen |= DeadlineField;
+            }
+            return true;
+        }
+
+        bool start_object(std::size_t) override {
+            ++depth;
+            if (depth == 1) taskDepth = 3;
+            else if (depth == 2 && taskDepth == 3 && rootKey == "ids") ids.emplace();
+            else if (depth == taskDepth && inTaskList()) {  // a new task begins
+                seen = 0;
+                id = 0;
+            }
+            else if (depth < taskDepth || !inTaskList()) throw std::runtime_error("Unexpected object in task file");
+            return true;
+        }
+
+        bool key(string_t& val) override {
+            if (depth == 1) rootKey.swap(val);
+            else if (depth == taskDepth || (depth == 2 && rootKey == "ids")) currentKey.swap(val);
+            return true;
+        }
+
+        bool end_object() override {
+            if (depth == taskDepth && inTaskList()) {
+                if (seen != AllFields) throw std::runtime_error("Task entry is missing required fields");
+                // id is optional: files from before ids get them on load
+                tasks.push_back(title, description, deadline, static_cast<Priority>(priority), tag, completed, id);
+            }
+            --depth;
+            return true;
+        }
+
+        bool start_array(std::size_t) override {
+            ++depth;
+            if (depth == 1) taskDepth = 2;
+            else if (depth == 2 && rootKey != "tasks") throw std::runtime_error("Expected an array of tasks");
+            else if (depth == 3 && rootKey == "ids" && currentKey != "free") return skipOrFail("array");
+            return true;
+        }
+
+        bool end_array() override {
+            --depth;
+            return true;
+        }
+
+        bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex) override {
+            throw std::runtime_error(ex.what());
+        }
+
+    private:
+        enum Field : unsigned {
+            TitleField = 1, DescriptionField = 2, DeadlineField = 4,
+            PriorityField = 8, TagField = 16, CompletedField = 32,
+            AllFields = 63
+        };
+
+        bool inTaskList() const { return taskDepth == 2 || rootKey == "tasks"; }
+        // True while positioned on a direct member of a task object
+        bool inTaskField() const { return depth == taskDepth && inTaskList(); }
+        bool inIdState() const { return taskDepth == 3 && depth >= 2 && rootKey == "ids"; }
+
+        bool idStateNumber(TaskId val) {
+            if (depth == 2 && currentKey == "slots" && val <= UINT32_MAX) ids->slotCount = static_cast<uint32_t>(val);
+            else if (depth == 3 && currentKey == "free") ids->freeIds.push_back(val);
+            else throw std::runtime_error("Task id state is malformed");
+            return true;
+        }
+
+        bool number(long long val) {
+            if (inIdState()) throw std::runtime_error("Task id state is malformed");
+            if (inTaskField() && currentKey == "id") {
+                id = static_cast<TaskId>(val);
+                return true;
+            }
+            if (inTaskField() && currentKey == "priority") {
+                priority = static_cast<int>(val);
+                seen |= PriorityField;
+                return true;
+            }
+            if (inTaskField() && currentKey == "deadline") {
+                deadline = DateTimeUtils::fromEpochSeconds(val);
+                seen |= DeadlineField;
+                ++epochDeadlines;
+                return true;
+            }
+            return skipOrFail("number");
+        }
+
+        // Values of unknown keys are ignored; anything outside a task object is malformed
+        bool skipOrFail(const char* what) {
+            if (depth < taskDepth || !inTaskList()) throw std::runtime_error(std::string("Unexpected ") + what + " in task list");
+            return true;
+        }
+
+        TaskTable& tasks;
+        int depth = 0;
+        int taskDepth = 2; // depth of the task objects: 2 in a bare array, 3 under "tasks"
+        std::string rootKey;
+        unsigned seen = 0;
+        std::string currentKey;
+
+        std::string title;
+        std::string description;
+        std::string tag;
+        std::chrono::system_clock::time_point deadline;
+        int priority = 0;
+        bool completed = false;
+        TaskId id = 0;
+    };
+}
+
+JsonStorage::JsonStorage(DeadlineEncoding deadlineEncoding)
+    : deadlineEncoding(deadlineEncoding) {
+}
+
+JsonStorage::DeadlineEncoding JsonStorage::getDeadlineEncoding() const {
+    return deadlineEncoding;
+}
+
+void JsonStorage::setDeadlineEncoding(DeadlineEncoding encoding) {
+    deadlineEncoding = encoding;
+}
+
+// Saves a list of tasks to a JSON file (pretty-printed), replacing it atomically
+// Of the extras only the id state is kept; the index orders are cheap to rebuild next to parsing
+void JsonStorage::saveToFile(const std::string& filename, const TaskTable& tasks, const TaskFileExtras* extras) {
+    const std::string tempPath = tempPathFor(filename);
+    std::ofstream outFile(tempPath);
+    if (!outFile) throw std::runtime_error("Cannot open file for writing: " + tempPath);
+
+    json j = json::array();
+    for (TaskRef task : tasks) j.push_back(task); // calls to_json for each task
+    if (deadlineEncoding == DeadlineEncoding::EpochSeconds) {
+        for (size_t i = 0; i < tasks.size(); ++i) {
+            j[i]["deadline"] = DateTimeUtils::toEpochSeconds(tasks.deadline(i));
+        }
+    }
+    if (extras && extras->ids) {
+        const SlotMapState& ids = *extras->ids;
+        j = json{ { "ids", { { "slots", ids.slotCount }, { "free", ids.freeIds } } }, { "tasks", std::move(j) } };
+    }
     outFile << j.dump(4);     // pretty-print with 4-space indent
+    outFile.close();
+    if (!outFile) throw std::runtime_error("Failed to write tasks: " + tempPath);
+
+    publish(tempPath, filename);
 }
 
-// Loads tasks from a JSON file (returns empty list if file doesn't exist)
-std::vector<Task> JsonStorage::loadFromFile(const std::string& filename) {
-    std::ifstream inFile(filename);
+// Loads tasks from a JSON file (returns empty list if file doesn't exist).
+// The file is streamed through a SAX handler, so peak memory stays close to the loaded tasks.
+TaskTable JsonStorage::loadFromFile(const std::string& filename, TaskFileExtras* extras) {
+    auto started = std::chrono::steady_clock::now();
+    lastLoadStats = LoadStats{};
+
+    std::ifstream inFile(filename, std::ios::binary);
     if (!inFile) return {};   // file not found
 
-    json j;
-    inFile >> j;
-    return j.get<std::vector<Task>>(); // calls from_json for each
+    std::error_code ec;
+    std::uintmax_t fileSize = std::filesystem::file_size(filename, ec);
+    if (ec) fileSize = 0;
+
+    TaskTable tasks;
+    tasks.reserve(static_cast<size_t>(fileSize / approxBytesPerTask));
+
+    TaskSaxHandler handler(tasks);
+    json::sax_parse(inFile, &handler);
+    if (extras) extras->ids = std::move(handler.ids);
+    if (!tasks.empty()) {
+        deadlineEncoding = handler.epochDeadlines == tasks.size() ? DeadlineEncoding::EpochSeconds : DeadlineEncoding::Text;
+    }
+
+    lastLoadStats.tasks = tasks.size();
+    lastLoadStats.bytes = fileSize;
+    lastLoadStats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    return tasks;
 }
\ No newline at end of file
@@ -2,10 +2,22 @@
 
 #include <string>
 #include <vector>
-#include "Task.h"
+#include "TaskStorage.h"
 
-class JsonStorage {
+class JsonStorage : public TaskStorage {
 public:
-    static void saveToFile(const std::string& filename, const std::vector<Task>& tasks);
-    static std::vector<Task> loadFromFile(const std::string& filename);
+    // How deadlines are written: local standard-time text, or epoch seconds (a plain integer
+    // read when loading). Both are accepted on load; a load adopts the encoding it found.
+    enum class DeadlineEncoding { Text, EpochSeconds };
+
+    explicit JsonStorage(DeadlineEncoding deadlineEncoding = DeadlineEncoding::Text);
+
+    DeadlineEncoding getDeadlineEncoding() const;
+    void setDeadlineEncoding(DeadlineEncoding encoding);
+
+    void saveToFile(const std::string& filename, const TaskTable& tasks, const TaskFileExtras* extras = nullptr) override;
+    TaskTable loadFromFile(const std::string& filename, TaskFileExtras* extras = nullptr) override;
+
+private:
+    DeadlineEncoding deadlineEncoding;
 };
\ No newline at end of file
@@ -0,0 +1,168 @@
+#include "TaskJournal.h"
+#include <filesystem>
+#include <stdexcept>
+
+using json = nlohmann::json;
+
+// Write-ahead journal of task mutations with group commit
+
+TaskJournal::TaskJournal(size_t groupCommitBytes)
+    : groupCommitBytes(groupCommitBytes) {
+}
+
+TaskJournal::~TaskJournal() {
+    close();
+}
+
+// Opens (or creates) the journal for appending
+void TaskJournal::open(const std::string& journalPath) {
+    close();
+    out.open(journalPath, std::ios::binary | std::ios::app);
+    if (!out) throw std::runtime_error("Cannot open journal: " + journalPath);
+
+    path = journalPath;
+    std::error_code ec;
+    committedBytes = std::filesystem::file_size(journalPath, ec);
+    if (ec) committedBytes = 0;
+}
+
+// Commits whatever is still buffered and closes the file
+void TaskJournal::close() {
+    if (!out.is_open()) return;
+    commit();
+    out.close();
+}
+
+bool TaskJournal::isOpen() const {
+    return out.is_open();
+}
+
+const std::string& TaskJournal::getPath() const {
+    return path;
+}
+
+void TaskJournal::recordAdd(const Task& task) {
+    append(json{ {"op", "add"}, {"task", task} });
+}
+
+void TaskJournal::recordEdit(TaskId id, const Task& task) {
+    append(json{ {"op", "edit"}, {"id", id}, {"task", task} });
+}
+
+void TaskJournal::recordRemove(TaskId id) {
+    append(json{ {"op", "remove"}, {"id", id} });
+}
+
+void TaskJournal::recordCompleted(TaskId id, bool completed) {
+    append(json{ {"op", "complete"}, {"id", id}, {"completed", completed} });
+}
+
+void TaskJournal::append(const json& record) {
+    if (!out.is_open()) return;
+    pending += record.dump();
+    pending += '\n';
+    if (pending.size() >= groupCommitBytes) commit();
+}
+
+// Writes all buffered records in one go and flushes them to the file
+void TaskJournal::commit() {
+    if (!out.is_open() || pending.empty()) return;
+    out.write(pending.data(), static_cast<std::streamsize>(pending.size()));
+    out.flush();
+    if (!out) throw std::runtime_error("Failed to write journal: " + path);
+    committedBytes += pending.size();
+    pending.clear();
+}
+
+// Drops every record (after they were folded into a new snapshot)
+void TaskJournal::truncate() {
+    if (!out.is_open()) return;
+    pending.clear();
+    out.close();
+    out.open(path, std::ios::binary | std::ios::trunc);
+    if (!out) throw std::runtime_error("Cannot reopen journal: " + path);
+    committedBytes = 0;
+}
+
+// Size of the journal including records not yet committed
+std::uintmax_t TaskJournal::size() const {
+    return committedBytes + pending.size();
+}
+
+std::string TaskJournal::sealedPathFor(const std::string& journalPath) {
+    return journalPath + ".sealed";
+}
+
+std::string TaskJournal::seal() {
+    if (!out.is_open()) throw std::runtime_error("Journal is not open");
+    commit();
+    out.close();
+
+    std::string sealedPath = sealedPathFor(path);
+    std::filesystem::rename(path, sealedPath);
+    open(path);
+    return sealedPath;
+}
+
+void TaskJournal::unseal(const std::string& sealedPath) {
+    if (!out.is_open()) throw std::runtime_error("Journal is not open");
+    commit();
+    out.close();
+
+    {
+        std::ofstream merged(sealedPath, std::ios::binary | std::ios::app);
+        std::ifstream live(path, std::ios::binary);
+        if (!merged) throw std::runtime_error("Cannot reopen sealed journal: " + sealedPath);
+        if (live && live.peek() != std::ifstream::traits_type::eof()) merged << live.rdbuf();
+        if (!merged) throw std::runtime_error("Failed to merge journal: " + sealedPath);
+    }
+    std::filesystem::rename(sealedPath, path);
+    open(path);
+}
+
+JournalReplay TaskJournal::replay(const std::string& journalPath, const std::function<void(const JournalRecord&)>& apply) {
+    JournalReplay result;
+    std::ifstream in(journalPath, std::ios::binary);
+    if (!in) return result;
+
+    std::string line;
+    while (std::getline(in, line)) {
+        if (in.eof()) break; // last line without its newline: the write was cut short
+        const std::uintmax_t offset = result.intactBytes;
+        result.intactBytes += line.size() + 1;
+        if (line.empty()) continue;
+
+        JournalRecord record;
+        try {
+            json j = json::parse(line);
+            std::string op = j.at("op").get<std::string>();
+            if (op != "add") record.id = j.at("id").get<TaskId>();
+            if (op == "add") {
+                record.op = JournalRecord::Op::Add;
+                record.task = j.at("task").get<Task>();
+            }
+            else if (op == "edit") {
+                record.op = JournalRecord::Op::Edit;
+                record.task = j.at("task").get<Task>();
+            }
+            else if (op == "remove") {
+                record.op = JournalRecord::Op::Remove;
+            }
+            else if (op == "complete") {
+                record.op = JournalRecord::Op::SetCompleted;
+                record.completed = j.at("completed").get<bool>();
+            }
+            else {
+                throw std::runtime_error("Unknown journal operation: " + op);
+            }
+        }
+        catch (const std::exception&) {
+            result.corruptOffsets.push_back(offset); // damaged or foreign record; the ones after it still apply
+            continue;
+        }
+
+        apply(record);
+        ++result.replayed;
+    }
+    return result;
+}
\ No newline at end of file
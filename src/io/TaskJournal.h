@@ -0,0 +1,69 @@
+#pragma once
+
+#include <string>
+#include <fstream>
+#include <functional>
+#include <cstdint>
+#include <vector>
+#include "Task.h"
+
+// A single logged TaskManager mutation
+struct JournalRecord {
+    enum class Op { Add, Edit, Remove, SetCompleted };
+
+    Op op = Op::Add;
+    TaskId id = 0;          // target task (Edit, Remove, SetCompleted)
+    Task task;              // new contents (Add, Edit)
+    bool completed = false; // new status (SetCompleted)
+};
+
+// What a replay found in a journal
+struct JournalReplay {
+    size_t replayed = 0;
+    std::uintmax_t intactBytes = 0;             // offset just past the last complete line
+    std::vector<std::uintmax_t> corruptOffsets; // complete lines that did not parse; skipped
+};
+
+// Append-only write-ahead log of task mutations, one JSON object per line.
+// Records are buffered and written in groups: on commit(), or once the buffer fills up.
+class TaskJournal {
+public:
+    explicit TaskJournal(size_t groupCommitBytes = 64 * 1024);
+    ~TaskJournal();
+
+    void open(const std::string& path);
+    void close();
+    bool isOpen() const;
+    const std::string& getPath() const;
+
+    void recordAdd(const Task& task);
+    void recordEdit(TaskId id, const Task& task);
+    void recordRemove(TaskId id);
+    void recordCompleted(TaskId id, bool completed);
+
+    void commit();
+    void truncate();
+    std::uintmax_t size() const;
+
+    // Moves the committed records aside (to sealedPathFor(path)) and continues in an empty journal,
+    // so a snapshot can be written without holding up new records
+    std::string seal();
+    // Puts sealed records back in front of the live ones (e.g. when the snapshot could not be written)
+    void unseal(const std::string& sealedPath);
+    static std::string sealedPathFor(const std::string& path);
+
+    // Feeds every intact record of the journal at path to apply. A torn trailing line (e.g. after
+    // a crash mid-write) ends the replay; anything past intactBytes must be cut off before
+    // appending to the file again. A complete line that does not parse is skipped and its
+    // offset reported, so the records after it are not lost.
+    static JournalReplay replay(const std::string& path, const std::function<void(const JournalRecord&)>& apply);
+
+private:
+    void append(const nlohmann::json& record);
+
+    std::string path;
+    std::ofstream out;
+    std::string pending;
+    size_t groupCommitBytes;
+    std::uintmax_t committedBytes = 0;
+};
\ No newline at end of file
@@ -0,0 +1,32 @@
+#include "TaskStorage.h"
+#include "JsonStorage.h"
+#include "BinaryStorage.h"
+#include <filesystem>
+
+LoadStats TaskStorage::lastLoadStats;
+
+double LoadStats::megabytesPerSecond() const {
+    return seconds > 0.0 ? (bytes / (1024.0 * 1024.0)) / seconds : 0.0;
+}
+
+std::unique_ptr<TaskStorage> TaskStorage::forFile(const std::string& filename) {
+    const std::string snapshotExt = ".snap";
+    bool isSnapshot = filename.size() >= snapshotExt.size() &&
+        filename.compare(filename.size() - snapshotExt.size(), snapshotExt.size(), snapshotExt) == 0;
+
+    if (isSnapshot) return std::make_unique<BinaryStorage>();
+    return std::make_unique<JsonStorage>();
+}
+
+std::string TaskStorage::tempPathFor(const std::string& filename) {
+    return filename + ".tmp";
+}
+
+// Atomically replaces filename with the completed temp file
+void TaskStorage::publish(const std::string& tempPath, const std::string& filename) {
+    std::filesystem::rename(tempPath, filename);
+}
+
+const LoadStats& TaskStorage::getLastLoadStats() {
+    return lastLoadStats;
+}
\ No newline at end of file
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <optional>
+#include <cstdint>
+#include "Task.h"
+#include "TaskTable.h"
+#include "SlotMap.h"
+
+// Throughput figures of the most recent load
+struct LoadStats {
+    size_t tasks = 0;
+    std::uintmax_t bytes = 0;
+    double seconds = 0.0;
+
+    double megabytesPerSecond() const;
+};
+
+// What a backend can save next to the tasks, so that a load need not rebuild it. Every part
+// is optional: loading a file saved without a part (or by a backend that does not store it)
+// leaves that part empty.
+struct TaskFileExtras {
+    std::optional<SlotMapState> ids;
+    std::vector<uint32_t> deadlineOrder; // rows, soonest deadline first
+    std::vector<uint32_t> priorityOrder; // rows in the order of TaskManager's priority index
+};
+
+// Common interface of the persistence backends (JSON text, binary snapshot)
+class TaskStorage {
+public:
+    virtual ~TaskStorage() = default;
+
+    // extras, when given, is saved alongside the tasks and handed back by loadFromFile
+    virtual void saveToFile(const std::string& filename, const TaskTable& tasks, const TaskFileExtras* extras = nullptr) = 0;
+    virtual TaskTable loadFromFile(const std::string& filename, TaskFileExtras* extras = nullptr) = 0;
+    // Whether the index orders of TaskFileExtras are saved, so callers only compute them then
+    virtual bool savesIndexOrders() const { return false; }
+
+    // Picks the backend from the file extension: ".snap" is a binary snapshot, anything else JSON
+    static std::unique_ptr<TaskStorage> forFile(const std::string& filename);
+    static const LoadStats& getLastLoadStats();
+
+protected:
+    // Backends write into a temp file next to the target and then publish it,
+    // so readers and crashes never observe a half-written file
+    static std::string tempPathFor(const std::string& filename);
+    static void publish(const std::string& tempPath, const std::string& filename);
+
+    static LoadStats lastLoadStats;
+};
\ No newline at end of file
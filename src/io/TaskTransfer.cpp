@@ -0,0 +1,427 @@
+#include "TaskTransfer.h"
+#include "DateTimeUtils.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <future>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+
+using json = nlohmann::json;
+
+namespace {
+    enum class Column { Title, Description, Deadline, Priority, Tag, Completed, Ignored };
+
+    const char* const csvHeader = "title,description,deadline,priority,tag,completed,id\n";
+
+    // What a worker made of one block of text
+    struct ParsedBlock {
+        std::vector<Task> tasks;
+        size_t lines = 0;     // line breaks in the block
+        size_t skipped = 0;
+        size_t errorLine = 0; // first bad row, counted from the block's first line
+        std::string error;
+    };
+
+    size_t workerCount(const TransferOptions& options) {
+        if (options.threads > 0) return options.threads;
+        return std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+
+    bool equalsIgnoreCase(const std::string& text, const char* word) {
+        size_t length = std::strlen(word);
+        if (text.size() != length) return false;
+        for (size_t i = 0; i < length; ++i) {
+            if (std::tolower(static_cast<unsigned char>(text[i])) != word[i]) return false;
+        }
+        return true;
+    }
+
+    // Reads the CSV record starting at pos into the first fields, reusing their storage, and
+    // returns how many fields it had. Quoted fields may hold commas, doubled quotes and line
+    // breaks; every line break consumed is added to lines.
+    size_t readCsvRecord(const std::string& text, size_t& pos, std::vector<std::string>& fields, size_t& lines) {
+        size_t count = 0;
+        auto nextField = [&]() -> std::string& {
+            if (count == fields.size()) fields.emplace_back();
+            fields[count].clear();
+            return fields[count++];
+        };
+
+        std::string* field = &nextField();
+        bool quoted = false;
+        while (pos < text.size()) {
+            if (quoted) {
+                size_t quote = std::min(text.find('"', pos), text.size()); // unterminated: runs to the end
+                lines += std::count(text.begin() + pos, text.begin() + quote, '\n');
+                field->append(text, pos, quote - pos);
+                pos = std::min(quote + 1, text.size());
+                if (pos < text.size() && text[pos] == '"') {
+                    *field += '"';
+                    ++pos;
+                }
+                else {
+                    quoted = false;
+                }
+                continue;
+            }
+
+            size_t start = pos;
+            while (pos < text.size() && text[pos] != ',' && text[pos] != '"' && text[pos] != '\n' && text[pos] != '\r') ++pos;
+            field->append(text, start, pos - start);
+            if (pos == text.size()) break;
+
+            char c = text[pos++];
+            if (c == '"') quoted = true;
+            else if (c == ',') field = &nextField();
+            else if (c == '\n') {
+                ++lines;
+                break;
+            }
+        }
+        return count;
+    }
+
+    std::chrono::system_clock::time_point parseDeadline(const std::string& text) {
+        bool epoch = !text.empty() && std::all_of(text.begin() + (text[0] == '-' ? 1 : 0), text.end(),
+            [](char c) { return c >= '0' && c <= '9'; });
+        if (epoch && text != "-") return DateTimeUtils::fromEpochSeconds(std::stoll(text));
+        return DateTimeUtils::stringToTimePoint(text);
+    }
+
+    Priority parsePriority(const std::string& text) {
+        if (text.empty() || text == "0" || equalsIgnoreCase(text, "low")) return Priority::Low;
+        if (text == "1" || equalsIgnoreCase(text, "medium")) return Priority::Medium;
+        if (text == "2" || equalsIgnoreCase(text, "high")) return Priority::High;
+        throw std::runtime_error("bad priority '" + text + "'");
+    }
+
+    bool parseCompleted(const std::string& text) {
+        if (text.empty() || text == "0" || equalsIgnoreCase(text, "false") || equalsIgnoreCase(text, "no")) return false;
+        if (text == "1" || equalsIgnoreCase(text, "true") || equalsIgnoreCase(text, "yes")) return true;
+        throw std::runtime_error("bad completed value '" + text + "'");
+    }
+
+    std::vector<Column> parseCsvHeader(const std::vector<std::string>& fields, size_t count) {
+        static const std::pair<const char*, Column> names[] = {
+            { "title", Column::Title }, { "description", Column::Description }, { "deadline", Column::Deadline },
+            { "priority", Column::Priority }, { "tag", Column::Tag }, { "completed", Column::Completed } };
+
+        std::vector<Column> columns(count, Column::Ignored);
+        for (size_t i = 0; i < count; ++i) {
+            for (const auto& name : names) {
+                if (equalsIgnoreCase(fields[i], name.first)) columns[i] = name.second;
+            }
+        }
+        for (Column needed : { Column::Title, Column::Deadline }) {
+            if (std::find(columns.begin(), columns.end(), needed) == columns.end()) {
+                throw std::runtime_error("CSV header needs 'title' and 'deadline' columns");
+            }
+        }
+        return columns;
+    }
+
+    // Builds a task from a record; the fields' text is moved out
+    Task taskFromRecord(std::vector<std::string>& fields, size_t count, const std::vector<Column>& columns) {
+        std::string title, description, tag;
+        std::chrono::system_clock::time_point deadline;
+        Priority priority = Priority::Low;
+        bool completed = false, hasDeadline = false;
+
+        for (size_t i = 0; i < count && i < columns.size(); ++i) {
+            switch (columns[i]) {
+            case Column::Title: title = std::move(fields[i]); break;
+            case Column::Description: description = std::move(fields[i]); break;
+            case Column::Deadline:
+                if (fields[i].empty()) break;
+                deadline = parseDeadline(fields[i]);
+                hasDeadline = true;
+                break;
+            case Column::Priority: priority = parsePriority(fields[i]); break;
+            case Column::Tag: tag = std::move(fields[i]); break;
+            case Column::Completed: completed = parseCompleted(fields[i]); break;
+            case Column::Ignored: break;
+            }
+        }
+        if (title.empty()) throw std::runtime_error("missing title");
+        if (!hasDeadline) throw std::runtime_error("missing deadline");
+        return Task(std::move(title), std::move(description), deadline, priority, std::move(tag), completed);
+    }
+
+    void noteError(ParsedBlock& block, size_t line, const char* what) {
+        if (block.skipped++ == 0) {
+            block.errorLine = line;
+            block.error = what;
+        }
+    }
+
+    ParsedBlock parseCsvBlock(const std::string& text, const std::vector<Column>& columns) {
+        ParsedBlock block;
+        block.tasks.reserve(text.size() / 64);
+        std::vector<std::string> fields;
+        size_t pos = 0;
+        while (pos < text.size()) {
+            size_t line = block.lines;
+            size_t count = readCsvRecord(text, pos, fields, block.lines);
+            if (count == 1 && fields[0].empty()) continue; // blank line
+            try {
+                block.tasks.push_back(taskFromRecord(fields, count, columns));
+            }
+            catch (const std::exception& e) {
+                noteError(block, line, e.what());
+            }
+        }
+        return block;
+    }
+
+    ParsedBlock parseNdjsonBlock(const std::string& text) {
+        ParsedBlock block;
+        block.tasks.reserve(text.size() / 128);
+        const char* pos = text.data();
+        const char* end = pos + text.size();
+        while (pos < end) {
+            const char* newline = static_cast<const char*>(std::memchr(pos, '\n', end - pos));
+            const char* lineEnd = newline ? newline : end;
+            size_t line = block.lines;
+            if (newline) ++block.lines;
+
+            if (std::any_of(pos, lineEnd, [](char c) { return !std::isspace(static_cast<unsigned char>(c)); })) {
+                try {
+                    block.tasks.push_back(json::parse(pos, lineEnd).get<Task>());
+                }
+                catch (const std::exception& e) {
+                    noteError(block, line, e.what());
+                }
+            }
+            pos = lineEnd + (newline ? 1 : 0);
+        }
+        return block;
+    }
+
+    // End of the last complete record in text, or npos if there is none. A line break only
+    // ends a CSV record when an even number of quotes precede it (the block starts outside quotes).
+    size_t recordCut(TransferFormat format, const std::string& text) {
+        if (format == TransferFormat::Ndjson) {
+            size_t newline = text.rfind('\n');
+            return newline == std::string::npos ? newline : newline + 1;
+        }
+
+        size_t quotes = std::count(text.begin(), text.end(), '"');
+        for (size_t i = text.size(); i-- > 0;) {
+            if (text[i] == '"') --quotes;
+            else if (text[i] == '\n' && quotes % 2 == 0) return i + 1;
+        }
+        return std::string::npos;
+    }
+
+    // JSON string literal; UTF-8 passes through unchanged
+    void appendJsonString(std::string& out, std::string_view text) {
+        static const char hex[] = "0123456789abcdef";
+        out += '"';
+        for (char c : text) {
+            switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            case '\b': out += "\\b"; break;
+            case '\f': out += "\\f"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    out += "\\u00";
+                    out += hex[c >> 4];
+                    out += hex[c & 0xF];
+                }
+                else {
+                    out += c;
+                }
+            }
+        }
+        out += '"';
+    }
+
+    void appendCsvField(std::string& out, std::string_view text) {
+        if (text.find_first_of(",\"\r\n") == std::string_view::npos) {
+            out += text;
+            return;
+        }
+        out += '"';
+        for (char c : text) {
+            if (c == '"') out += '"';
+            out += c;
+        }
+        out += '"';
+    }
+}
+
+double ImportStats::megabytesPerSecond() const {
+    return seconds > 0.0 ? (bytes / (1024.0 * 1024.0)) / seconds : 0.0;
+}
+
+TransferFormat transferFormatForFile(const std::string& filename) {
+    auto endsWith = [&filename](const std::string& suffix) {
+        return filename.size() >= suffix.size() && filename.compare(filename.size() - suffix.size(), suffix.size(), suffix) == 0;
+    };
+    if (endsWith(".csv")) return TransferFormat::Csv;
+    if (endsWith(".ndjson") || endsWith(".jsonl")) return TransferFormat::Ndjson;
+    throw std::runtime_error("Unknown bulk format (use .csv, .ndjson or .jsonl): " + filename);
+}
+
+
+TaskImporter::TaskImporter(TransferFormat format, TransferOptions options)
+    : format(format), options(options) {
+    if (this->options.blockBytes == 0) this->options.blockBytes = TransferOptions().blockBytes;
+}
+
+ImportStats TaskImporter::run(std::istream& in, const Sink& sink) {
+    auto started = std::chrono::steady_clock::now();
+    const size_t workers = workerCount(options);
+
+    ImportStats stats;
+    std::vector<Column> columns;
+    size_t line = 1; // first line of the oldest block in flight
+    std::deque<std::future<ParsedBlock>> inFlight;
+
+    auto collectOldest = [&]() {
+        ParsedBlock block = inFlight.front().get();
+        inFlight.pop_front();
+        if (block.skipped > 0 && stats.skipped == 0) {
+            stats.firstError = "line " + std::to_string(line + block.errorLine) + ": " + block.error;
+        }
+        stats.skipped += block.skipped;
+        stats.imported += block.tasks.size();
+        line += block.lines;
+        sink(std::move(block.tasks));
+    };
+
+    std::string carry;
+    bool headerDone = format != TransferFormat::Csv;
+    bool first = true;
+    while (true) {
+        std::string block = std::move(carry);
+        carry.clear();
+        const size_t kept = block.size();
+        block.resize(kept + options.blockBytes);
+        in.read(&block[kept], static_cast<std::streamsize>(options.blockBytes));
+        const size_t got = static_cast<size_t>(in.gcount());
+        block.resize(kept + got);
+        stats.bytes += got;
+        if (in.bad()) throw std::runtime_error("Failed to read import data");
+        const bool end = got < options.blockBytes;
+
+        if (first) {
+            if (block.compare(0, 3, "\xEF\xBB\xBF") == 0) block.erase(0, 3); // UTF-8 byte order mark
+            first = false;
+        }
+
+        size_t cut = end ? block.size() : recordCut(format, block);
+        if (cut == std::string::npos) {
+            carry = std::move(block); // a record longer than a block: read on
+            continue;
+        }
+
+        if (!headerDone) {
+            std::vector<std::string> fields;
+            size_t pos = 0, headerLines = 0;
+            size_t count = readCsvRecord(block, pos, fields, headerLines);
+            if (block.empty()) throw std::runtime_error("CSV file is empty");
+            columns = parseCsvHeader(fields, count);
+            block.erase(0, pos);
+            cut -= pos;
+            line += headerLines;
+            headerDone = true;
+        }
+
+        carry.assign(block, cut, std::string::npos);
+        block.resize(cut);
+        if (!block.empty()) {
+            if (inFlight.size() >= workers) collectOldest();
+            inFlight.push_back(std::async(std::launch::async, [this, &columns, text = std::move(block)]() {
+                return format == TransferFormat::Csv ? parseCsvBlock(text, columns) : parseNdjsonBlock(text);
+            }));
+        }
+        if (end) break;
+    }
+    while (!inFlight.empty()) collectOldest();
+
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    return stats;
+}
+
+
+TaskExporter::TaskExporter(TransferFormat format, TransferOptions options)
+    : format(format), options(options) {
+}
+
+void TaskExporter::run(const TaskTable& tasks, std::ostream& out) {
+    const size_t workers = workerCount(options);
+    const size_t perChunk = std::max<size_t>(1, options.blockBytes / 128); // ~128 bytes per formatted task
+    std::deque<std::future<std::string>> inFlight;
+
+    auto writeOldest = [&]() {
+        std::string text = inFlight.front().get();
+        inFlight.pop_front();
+        out.write(text.data(), static_cast<std::streamsize>(text.size()));
+        if (!out) throw std::runtime_error("Failed to write export data");
+    };
+
+    if (format == TransferFormat::Csv) out << csvHeader;
+    for (size_t first = 0; first < tasks.size(); first += perChunk) {
+        size_t last = std::min(tasks.size(), first + perChunk);
+        if (inFlight.size() >= workers) writeOldest();
+        inFlight.push_back(std::async(std::launch::async, [this, &tasks, first, last]() {
+            return formatChunk(tasks, first, last);
+        }));
+    }
+    while (!inFlight.empty()) writeOldest();
+
+    out.flush();
+    if (!out) throw std::runtime_error("Failed to write export data");
+}
+
+std::string TaskExporter::formatChunk(const TaskTable& tasks, size_t first, size_t last) const {
+    static const char* const priorities[] = { "low", "medium", "high" };
+
+    std::string out;
+    out.reserve((last - first) * 128);
+    for (size_t i = first; i < last; ++i) {
+        TaskRef task = tasks[i];
+        if (format == TransferFormat::Ndjson) {
+            // Same object as to_json(Task) writes, keys in the same order, without building it
+            out += task.getCompleted() ? "{\"completed\":true,\"deadline\":\"" : "{\"completed\":false,\"deadline\":\"";
+            DateTimeUtils::appendTimePoint(out, task.getDeadline());
+            out += "\",\"description\":";
+            appendJsonString(out, task.getDescription());
+            if (task.getId() != 0) {
+                out += ",\"id\":";
+                out += std::to_string(task.getId());
+            }
+            out += ",\"priority\":";
+            out += static_cast<char>('0' + static_cast<int>(task.getPriority()));
+            out += ",\"tag\":";
+            appendJsonString(out, task.getTag());
+            out += ",\"title\":";
+            appendJsonString(out, task.getTitle());
+            out += "}\n";
+            continue;
+        }
+
+        appendCsvField(out, task.getTitle());
+        out += ',';
+        appendCsvField(out, task.getDescription());
+        out += ',';
+        DateTimeUtils::appendTimePoint(out, task.getDeadline());
+        out += ',';
+        out += priorities[static_cast<int>(task.getPriority())];
+        out += ',';
+        appendCsvField(out, task.getTag());
+        out += task.getCompleted() ? ",true," : ",false,";
+        out += std::to_string(task.getId());
+        out += '\n';
+    }
+    return out;
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Task.h"
+#include "TaskTable.h"
+
+// Streaming bulk import/export of tasks.
+//
+// CSV: a header row names the columns (title, description, deadline, priority, tag, completed;
+// any order, unknown ones ignored, title and deadline required), RFC 4180 quoting. Deadlines are
+// "YYYY-MM-DD HH:MM[:SS]" or epoch seconds, priorities low/medium/high or 0-2.
+// NDJSON: one task object per line, with the same fields as tasks.json.
+// Exports carry each task's id (as the last CSV column); imported tasks always get new ids.
+
+enum class TransferFormat { Csv, Ndjson };
+
+// ".csv" is CSV, ".ndjson" or ".jsonl" NDJSON; anything else throws std::runtime_error
+TransferFormat transferFormatForFile(const std::string& filename);
+
+struct TransferOptions {
+    size_t blockBytes = 4 * 1024 * 1024; // input is parsed, and output formatted, in blocks of about this size
+    size_t threads = 0;                  // blocks in flight at once; 0 means one per hardware thread
+};
+
+struct ImportStats {
+    size_t imported = 0;
+    size_t skipped = 0;     // rows that could not be turned into a task
+    std::string firstError; // e.g. "line 12: missing deadline"
+    std::uintmax_t bytes = 0;
+    double seconds = 0.0;
+
+    double megabytesPerSecond() const;
+};
+
+// Reads the input in blocks cut at record boundaries and parses up to `threads` blocks at a
+// time on worker threads. Parsed batches reach the sink on the calling thread, in file order,
+// so at most threads + 1 blocks of text are held at once.
+class TaskImporter {
+public:
+    using Sink = std::function<void(std::vector<Task>&&)>;
+
+    explicit TaskImporter(TransferFormat format, TransferOptions options = {});
+
+    // Bad rows are counted and skipped; a malformed CSV header or a read error throws std::runtime_error
+    ImportStats run(std::istream& in, const Sink& sink);
+
+private:
+    TransferFormat format;
+    TransferOptions options;
+};
+
+// Formats chunks of tasks on worker threads and writes them out in order
+class TaskExporter {
+public:
+    explicit TaskExporter(TransferFormat format, TransferOptions options = {});
+
+    // Throws std::runtime_error if the stream fails
+    void run(const TaskTable& tasks, std::ostream& out);
+
+private:
+    std::string formatChunk(const TaskTable& tasks, size_t first, size_t last) const;
+
+    TransferFormat format;
+    TransferOptions options;
+};
\ No newline at end of file
@@ -1,8 +1,12 @@
 ﻿#include "App.h"
 #include <iostream>
 
-int main() {
+int main(int argc, char* argv[]) {
     App app;
+    if (argc > 1) {
+        // Batch mode: run the given command (or script) and exit
+        return app.runBatch(std::vector<std::string>(argv + 1, argv + argc));
+    }
     app.run();
     std::cin.get();
     return 0;
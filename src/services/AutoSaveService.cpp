@@ -3,10 +3,10 @@
 #include <chrono>
 #include <iostream>
 
-AutoSaveService::AutoSaveService(std::shared_ptr<TaskManager> taskManager)
-    : running(false), filename("tasks.json"), taskManager(taskManager) {
-    // Constructor initializes the autosave flag, target filename and the shared TaskManager reference.
-    // NOTE: Consider making the filename configurable in the future.
+AutoSaveService::AutoSaveService(std::shared_ptr<TaskManager> taskManager, std::shared_ptr<Scheduler> scheduler)
+    : running(false), taskManager(taskManager), scheduler(scheduler) {
+    // Constructor initializes the autosave flag and the shared TaskManager reference.
+    // The target file is whatever the TaskManager loaded.
 }
 
 AutoSaveService::~AutoSaveService() {
@@ -16,28 +16,41 @@ AutoSaveService::~AutoSaveService() {
 void AutoSaveService::start() {
     if (running) return;
     running = true;
-    workerThread = std::thread(&AutoSaveService::run, this);
+    savedGeneration = taskManager->getGeneration(); // Changes made before start were loaded, not edited
+    job = scheduler->schedulePeriodic("autosave", [this]() { save(); }, std::chrono::minutes(2));
 }
 
 void AutoSaveService::stop() {
     if (!running) return;
     running = false;
-    cv.notify_all(); // Wake up the sleeping thread to allow exit.
-    if (workerThread.joinable())
-        workerThread.join();
+    scheduler->cancel(job); // Lets a save that is already running finish
 }
 
-void AutoSaveService::run() {
-    while (running) {
-        std::unique_lock<std::mutex> lock(cvMutex);
-        // Wait up to 2 minutes, or exit early if 'running' becomes false.
-        if (cv.wait_for(lock, std::chrono::minutes(2), [this]() { return !running; })) {
-            break;
-        }
-        {
-            std::lock_guard<std::mutex> lock(consoleMutex); // Wait until user ended some business in console, or block him until autosave
-            taskManager->saveTasks(filename); // Save tasks to file.
-            std::cout << "[AutoSaveService] Autosaved.\n>";
-        }
+// Runs every 2 minutes on the shared scheduler
+void AutoSaveService::save() {
+    // Skip intervals in which nothing was changed
+    uint64_t generation = taskManager->getGeneration();
+    if (generation == savedGeneration) return;
+
+    // Never takes the console lock to save: the journal commit and the snapshot are
+    // synchronized by the TaskManager itself, so saving doesn't wait for a pending prompt
+    std::optional<TaskManager::Compaction> compaction;
+    try {
+        compaction = taskManager->commitChangesDeferred();
+    }
+    catch (const std::exception&) {
+        return; // Already reported; savedGeneration stays behind so the next run retries
     }
+
+    // Serialize the snapshot outside of any lock; it lands in a temp file that is renamed over the snapshot
+    if (compaction) {
+        bool written = taskManager->writeCompaction(*compaction);
+        taskManager->finishCompaction(*compaction, written);
+        if (!written) return; // The sealed journal was merged back; retry next run
+    }
+    savedGeneration = generation;
+
+    // Report only if the console is free; a prompt in progress must not be interleaved
+    std::unique_lock<std::mutex> lock(consoleMutex, std::try_to_lock);
+    if (lock.owns_lock()) std::cout << "[AutoSaveService] Autosaved.\n>";
 }
\ No newline at end of file
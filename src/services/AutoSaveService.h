@@ -1,27 +1,25 @@
 #pragma once
 
-#include <thread>
 #include <atomic>
 #include <memory>
-#include <mutex>
-#include <condition_variable>
+#include <optional>
 #include "TaskManager.h"
+#include "Scheduler.h"
 
 class AutoSaveService {
 public:
-    AutoSaveService(std::shared_ptr<TaskManager> taskManager);
+    AutoSaveService(std::shared_ptr<TaskManager> taskManager, std::shared_ptr<Scheduler> scheduler);
     ~AutoSaveService();
 
     void start();
     void stop();
 
 private:
-    void run();
+    void save();
 
     std::atomic<bool> running;
     std::shared_ptr<TaskManager> taskManager;
-    std::thread workerThread;
-    std::mutex cvMutex;
-    std::condition_variable cv;
-    std::string filename;
+    std::shared_ptr<Scheduler> scheduler;
+    Scheduler::JobId job = 0;
+    uint64_t savedGeneration = 0;
 };
\ No newline at end of file
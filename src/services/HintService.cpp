@@ -2,8 +2,8 @@
 #include <iostream>
 #include <random>
 
-HintService::HintService(std::shared_ptr<TaskManager> taskManager)
-    : taskManager(taskManager), running(false) {
+HintService::HintService(std::shared_ptr<TaskManager> taskManager, std::shared_ptr<Scheduler> scheduler)
+    : taskManager(taskManager), scheduler(scheduler), running(false) {
 }
 
 HintService::~HintService() {
@@ -13,55 +13,46 @@ HintService::~HintService() {
 void HintService::start() {
     if (running) return;
     running = true;
-    worker = std::thread(&HintService::run, this);
+    job = scheduler->schedulePeriodic("hints", [this]() { check(); }, std::chrono::seconds(30)); // Check every 30 seconds
 }
 
 void HintService::stop() {
     if (!running) return;
-    running = false; 
-    cv.notify_all();// Unblocks thread if it's waiting
-    if (worker.joinable()) {
-        worker.join();
-    }
+    running = false;
+    scheduler->cancel(job); // Waits for a check that is already running
 }
 
-void HintService::run() {
-    const auto checkInterval = std::chrono::seconds(30); // Check every 30 seconds
+void HintService::check() {
     const auto inactivityThreshold = std::chrono::minutes(2); // Consider 2 mins as inactivity
 
-    while (running) {
-        {
-            std::unique_lock<std::mutex> lock(cvMutex);
-            if (cv.wait_for(lock, checkInterval, [this]() { return !running; })) {
-                break;
-            }
-        }
-
-        auto lastActivity = ActivityTracker::getLastActivityTime(); // Cross-thread singleton access
-        auto now = std::chrono::system_clock::now();
-        auto inactivityDuration = std::chrono::duration_cast<std::chrono::minutes>(now - lastActivity);
+    auto lastActivity = ActivityTracker::getLastActivityTime(); // Cross-thread singleton access
+    auto now = std::chrono::system_clock::now();
+    auto inactivityDuration = std::chrono::duration_cast<std::chrono::minutes>(now - lastActivity);
 
-        if (inactivityDuration >= inactivityThreshold) {
-            // User inactive for a while — provide contextual hints
-            {
-                std::lock_guard<std::mutex> lock(consoleMutex); // Sync with other console output
-                int overdue = taskManager->countOverduedDeadlines();
-                int upcoming = taskManager->countUpcomingDeadlines(); // Due within 48 hours
-
-                std::cout << "\n[Hint]: ";
-                if (overdue > 0) {
-                    std::cout << "You have " << overdue << " overdue tasks. ";
-                }
-                if (upcoming > 0) {
-                    std::cout << "You have " << upcoming << " upcoming tasks. ";
-                }
-                if (overdue == 0 && upcoming == 0) {
-                    std::cout << "You are doing great! ✅";
-                }
-                displayRandomMotivationalHint(); // Random extra encouragement
-                std::cout << "\nType 'help' to see available commands.\n\n>";
+    if (inactivityDuration >= inactivityThreshold) {
+        // User inactive for a while — provide contextual hints.
+        // Counting reads a published snapshot, so it never waits on the UI thread.
+        auto snapshot = taskManager->snapshot();
+        size_t overdue = snapshot->countIncompleteDueBefore(now);
+        size_t upcoming = snapshot->countIncompleteDueBetween(now, now + std::chrono::hours(48)); // Due within 48 hours
+        {
+            // Skip this round if a command is in progress; the user isn't idle then anyway
+            std::unique_lock<std::mutex> lock(consoleMutex, std::try_to_lock);
+            if (!lock.owns_lock()) return;
 
+            std::cout << "\n[Hint]: ";
+            if (overdue > 0) {
+                std::cout << "You have " << overdue << " overdue tasks. ";
+            }
+            if (upcoming > 0) {
+                std::cout << "You have " << upcoming << " upcoming tasks. ";
             }
+            if (overdue == 0 && upcoming == 0) {
+                std::cout << "You are doing great! ✅";
+            }
+            displayRandomMotivationalHint(); // Random extra encouragement
+            std::cout << "\nType 'help' to see available commands.\n\n>";
+
         }
     }
 }
@@ -1,29 +1,27 @@
 #pragma once
 
 #include <atomic>
-#include <thread>
 #include <chrono>
 #include "TaskManager.h"
 #include "ActivityTracker.h"
 #include "ConsoleMutex.h"
-#include <condition_variable>
+#include "Scheduler.h"
 
 
 class HintService {
 public:
-    HintService(std::shared_ptr<TaskManager> taskManager);
+    HintService(std::shared_ptr<TaskManager> taskManager, std::shared_ptr<Scheduler> scheduler);
     ~HintService();
 
     void start();
     void stop();
 
 private:
-    void run();
+    void check();
     void displayRandomMotivationalHint();
 
     std::shared_ptr<TaskManager> taskManager;
+    std::shared_ptr<Scheduler> scheduler;
     std::atomic<bool> running;
-    std::thread worker;
-    std::mutex cvMutex;
-    std::condition_variable cv;
+    Scheduler::JobId job = 0;
 };
\ No newline at end of file
@@ -1,26 +1,11 @@
 #pragma once
 #include <string>
-#include <nlohmann/json.hpp>
+#include <chrono>
 
-// Represents a log event with timestamp and message
+// Represents a log event. The timestamp is kept raw so logging a message costs no
+// formatting; the logger's worker turns it into text when the event is written.
 struct LogEvent {
-    std::string timestamp;
+    std::chrono::system_clock::time_point time;
     std::string message;
 
-};
-
-using json = nlohmann::json;
-
-// Serialize LogEvent to JSON
-inline  void to_json(json& j, const LogEvent& event) {
-    j = json{
-        {"timestamp", event.timestamp},
-        {"message", event.message}
-    };
-}
-
-// Deserialize JSON to LogEvent
-inline void from_json(const json& j, LogEvent& event) {
-    j.at("timestamp").get_to(event.timestamp);
-    j.at("message").get_to(event.message);
-}
\ No newline at end of file
+};
\ No newline at end of file
@@ -0,0 +1,189 @@
+#include "LogSegments.h"
+#include "DateTimeUtils.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cctype>
+#include <ctime>
+#include <filesystem>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+static const std::string segmentPrefix = "segment-";
+static const std::string dataSuffix = ".ndjson";
+static const std::string indexSuffix = ".idx";
+static constexpr size_t writeChunkBytes = 64 * 1024;
+
+static LogSegmentFiles segmentFiles(const std::string& directory, uint64_t sequence) {
+    std::ostringstream name;
+    name << segmentPrefix << std::setw(6) << std::setfill('0') << sequence;
+    LogSegmentFiles files;
+    files.sequence = sequence;
+    files.dataPath = (fs::path(directory) / (name.str() + dataSuffix)).string();
+    files.indexPath = (fs::path(directory) / (name.str() + indexSuffix)).string();
+    return files;
+}
+
+std::vector<LogSegmentFiles> listLogSegments(const std::string& directory) {
+    std::vector<LogSegmentFiles> segments;
+    std::error_code ec;
+    if (!fs::is_directory(directory, ec)) return segments;
+
+    for (const auto& entry : fs::directory_iterator(directory, ec)) {
+        std::string name = entry.path().filename().string();
+        if (name.size() <= segmentPrefix.size() + dataSuffix.size() || name.compare(0, segmentPrefix.size(), segmentPrefix) != 0 ||
+            name.compare(name.size() - dataSuffix.size(), dataSuffix.size(), dataSuffix) != 0) {
+            continue;
+        }
+        std::string digits = name.substr(segmentPrefix.size(), name.size() - segmentPrefix.size() - dataSuffix.size());
+        if (digits.empty() || !std::all_of(digits.begin(), digits.end(), ::isdigit)) continue;
+        segments.push_back(segmentFiles(directory, std::stoull(digits)));
+    }
+
+    std::sort(segments.begin(), segments.end(),
+        [](const LogSegmentFiles& a, const LogSegmentFiles& b) { return a.sequence < b.sequence; });
+    return segments;
+}
+
+
+LogSegmentWriter::LogSegmentWriter(std::string directory, LogSegmentLimits limits)
+    : directory(std::move(directory)), limits(limits) {
+}
+
+// Continues the newest segment if it still has room, otherwise starts a new one
+void LogSegmentWriter::open() {
+    fs::create_directories(directory);
+    auto segments = listLogSegments(directory);
+
+    std::error_code ec;
+    if (!segments.empty() && fs::file_size(segments.back().dataPath, ec) < limits.segmentBytes && !ec) {
+        sequence = segments.back().sequence;
+        openSegment(segments.back());
+        segmentSize = static_cast<size_t>(fs::file_size(segments.back().dataPath));
+        nextIndexAt = segmentSize;
+        return;
+    }
+
+    sequence = segments.empty() ? 0 : segments.back().sequence;
+    rotate();
+}
+
+void LogSegmentWriter::close() {
+    flush();
+    data.close();
+    index.close();
+}
+
+void LogSegmentWriter::openSegment(const LogSegmentFiles& files) {
+    data.open(files.dataPath, std::ios::app | std::ios::binary);
+    index.open(files.indexPath, std::ios::app | std::ios::binary);
+    if (!data.is_open() || !index.is_open()) {
+        throw std::runtime_error("Failed to open log segment: " + files.dataPath);
+    }
+}
+
+// Closes the current segment, starts the next one and deletes segments beyond the retention limit
+void LogSegmentWriter::rotate() {
+    if (data.is_open()) close();
+
+    sequence++;
+    openSegment(segmentFiles(directory, sequence));
+    segmentSize = 0;
+    nextIndexAt = 0;
+
+    auto segments = listLogSegments(directory);
+    for (size_t i = 0; i + limits.maxSegments < segments.size(); ++i) {
+        std::error_code ec;
+        fs::remove(segments[i].dataPath, ec);
+        fs::remove(segments[i].indexPath, ec);
+    }
+}
+
+void LogSegmentWriter::append(std::chrono::system_clock::time_point time, const std::string& line) {
+    if (segmentSize > 0 && segmentSize + line.size() + 1 > limits.segmentBytes) rotate();
+
+    if (segmentSize >= nextIndexAt) {
+        index << std::chrono::system_clock::to_time_t(time) << ' ' << segmentSize << '\n';
+        nextIndexAt = segmentSize + limits.indexStrideBytes;
+    }
+
+    buffer += line;
+    buffer += '\n';
+    segmentSize += line.size() + 1;
+    if (buffer.size() >= writeChunkBytes) {
+        data.write(buffer.data(), buffer.size());
+        buffer.clear();
+    }
+}
+
+void LogSegmentWriter::flush() {
+    data.write(buffer.data(), buffer.size());
+    buffer.clear();
+    data.flush();
+    index.flush(); // after the data, so an entry never points past what was written
+}
+
+
+LogReader::LogReader(std::string directory)
+    : directory(std::move(directory)) {
+}
+
+std::chrono::system_clock::time_point LogReader::parseTimestamp(const std::string& text) {
+    return DateTimeUtils::wallClockStringToTimePoint(text); // the logger writes plain local time
+}
+
+// Each segment's index says when it starts; within a segment the reader seeks to the
+// last index entry before `from` and scans forward until it passes `to`
+std::vector<LogRecord> LogReader::read(std::chrono::system_clock::time_point from,
+    std::chrono::system_clock::time_point to) const {
+    using Entry = std::pair<std::time_t, std::streamoff>;
+
+    auto segments = listLogSegments(directory);
+    std::vector<std::vector<Entry>> indexes;
+    for (const auto& segment : segments) {
+        std::vector<Entry> entries;
+        std::ifstream in(segment.indexPath);
+        Entry entry;
+        while (in >> entry.first >> entry.second) entries.push_back(entry);
+        indexes.push_back(std::move(entries));
+    }
+
+    const std::time_t fromSecond = std::chrono::system_clock::to_time_t(from);
+    const std::time_t toSecond = std::chrono::system_clock::to_time_t(to);
+    const auto fromFloor = std::chrono::system_clock::from_time_t(fromSecond); // records carry whole seconds
+    std::vector<LogRecord> records;
+
+    for (size_t i = 0; i < segments.size(); ++i) {
+        const auto& entries = indexes[i];
+        if (!entries.empty() && entries.front().first > toSecond) break;
+        // Every record here is older than the next segment's first one
+        if (i + 1 < segments.size() && !indexes[i + 1].empty() && indexes[i + 1].front().first < fromSecond) continue;
+
+        auto after = std::lower_bound(entries.begin(), entries.end(), fromSecond,
+            [](const Entry& e, std::time_t second) { return e.first < second; });
+        std::streamoff offset = after == entries.begin() ? 0 : std::prev(after)->second;
+
+        std::ifstream in(segments[i].dataPath, std::ios::binary);
+        in.seekg(offset);
+        std::string line;
+        while (std::getline(in, line)) {
+            LogRecord record;
+            try {
+                auto j = nlohmann::json::parse(line);
+                j.at("timestamp").get_to(record.timestamp);
+                j.at("message").get_to(record.message);
+                record.time = parseTimestamp(record.timestamp);
+            }
+            catch (const std::exception&) {
+                continue; // a line torn by a crash
+            }
+
+            if (record.time < fromFloor) continue;
+            if (record.time > to) return records;
+            records.push_back(std::move(record));
+        }
+    }
+    return records;
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// The log is a directory of numbered, size-capped NDJSON segments. Next to each
+// segment-NNNNNN.ndjson is a segment-NNNNNN.idx file with one "<epoch seconds> <byte offset>"
+// line every few KiB, so a reader can seek close to a point in time instead of parsing
+// the whole log.
+
+struct LogSegmentFiles {
+    uint64_t sequence = 0;
+    std::string dataPath;
+    std::string indexPath;
+};
+
+// Existing segments of a log directory, oldest first
+std::vector<LogSegmentFiles> listLogSegments(const std::string& directory);
+
+struct LogSegmentLimits {
+    size_t segmentBytes = 1024 * 1024; // a segment is closed once it reaches this size
+    size_t maxSegments = 8;            // older segments are deleted on rotation
+    size_t indexStrideBytes = 4096;    // distance between index entries
+};
+
+// Appends lines to the newest segment, rotating and pruning as the limits require.
+// Not thread-safe: the logger's flush job is its only user.
+class LogSegmentWriter {
+public:
+    LogSegmentWriter(std::string directory, LogSegmentLimits limits);
+
+    void open();
+    void close();
+    // Buffers one line (without its newline) logged at the given time
+    void append(std::chrono::system_clock::time_point time, const std::string& line);
+    void flush();
+
+private:
+    void openSegment(const LogSegmentFiles& files);
+    void rotate();
+
+    std::string directory;
+    LogSegmentLimits limits;
+    uint64_t sequence = 0;
+    std::ofstream data;
+    std::ofstream index;
+    std::string buffer;
+    size_t segmentSize = 0;  // bytes in the segment, including the unwritten buffer
+    size_t nextIndexAt = 0;  // the first line at or after this offset gets an index entry
+};
+
+struct LogRecord {
+    std::chrono::system_clock::time_point time;
+    std::string timestamp;
+    std::string message;
+};
+
+class LogReader {
+public:
+    explicit LogReader(std::string directory);
+
+    // Records logged within [from, to], oldest first
+    std::vector<LogRecord> read(std::chrono::system_clock::time_point from,
+        std::chrono::system_clock::time_point to) const;
+
+    // Parses a local "YYYY-MM-DD HH:MM[:SS]" time as written in the log; throws std::runtime_error
+    static std::chrono::system_clock::time_point parseTimestamp(const std::string& text);
+
+private:
+    std::string directory;
+};
\ No newline at end of file
@@ -2,14 +2,18 @@
 #include <nlohmann/json.hpp>
 #include <chrono>
 #include <ctime>
-#include <iomanip>
-#include <sstream>
 #include <iostream>
+#include <thread>
 
 using json = nlohmann::json;
 
-LoggerService::LoggerService(const std::string& filename)
-    : filename(filename), running(false) {
+// Events are batched for this long before a flush
+static constexpr auto flushDelay = std::chrono::milliseconds(50);
+
+LoggerService::LoggerService(const std::string& directory, std::shared_ptr<Scheduler> scheduler,
+    LogSegmentLimits limits, size_t capacity, OverflowPolicy policy)
+    : directory(directory), scheduler(scheduler), policy(policy), ring(capacity), running(false),
+    segments(directory, limits) {
 }
 
 LoggerService::~LoggerService() {
@@ -18,73 +22,96 @@ LoggerService::~LoggerService() {
 
 void LoggerService::start() {
     if (running) return;
+    try {
+        segments.open();
+    }
+    catch (const std::exception& ex) {
+        std::cerr << "Failed to open log in " << directory << ": " << ex.what() << std::endl;
+        return;
+    }
+    flushPending = false; // events logged while stopped are picked up by this first flush
+    flushJob = scheduler->schedule("logger", [this]() { flush(); }, flushDelay);
     running = true;
-    worker = std::thread(&LoggerService::processEvents, this);
 }
 
 void LoggerService::stop() {
     if (!running) return;
-    {
-        std::lock_guard<std::mutex> lock(mutex);
-        running = false;
-    }
-    condVar.notify_one(); // Wake thread in case it's waiting with empty queue
-    if (worker.joinable()) {
-        worker.join();
-    }
+    running = false;
+    scheduler->cancel(flushJob); // Waits for a flush that is already running
+    flush(); // Write whatever was logged since
+    segments.close();
 }
 
+// Hot path: capture the time, move the message into the ring, and arm a flush
+// only if none is pending. Formatting and I/O happen on the flush job.
 void LoggerService::logEvent(const std::string& message) {
-    {
-        std::lock_guard<std::mutex> lock(mutex);
-        eventQueue.push(LogEvent{ getCurrentTime(), message }); // Push event in special log LogEvent format
-    }
-    condVar.notify_one(); // Ensure thread is notified even for single event
-}
+    LogEvent event{ std::chrono::system_clock::now(), message };
 
-void LoggerService::processEvents() {
-    std::ofstream outFile(filename, std::ios::app);
-    if (!outFile.is_open()) {
-        std::cerr << "Failed to open log file: " << filename << std::endl;
-        return;
+    while (!ring.tryPush(std::move(event))) {
+        if (policy == OverflowPolicy::Drop || !running) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        scheduler->rearm(flushJob); // Full: make the writer drain it now, then retry
+        std::this_thread::yield();
     }
+    logged.fetch_add(1, std::memory_order_relaxed);
 
-    try {
-        while (true) {
-            std::unique_lock<std::mutex> lock(mutex);
-            condVar.wait(lock, [this]() {
-                return !eventQueue.empty() || !running;
-                });
+    if (!flushPending.exchange(true, std::memory_order_acq_rel)) {
+        scheduler->rearm(flushJob, flushDelay);
+    }
+}
 
-            std::vector<LogEvent> batch;
-            while (!eventQueue.empty()) {
-                batch.push_back(eventQueue.front());
-                eventQueue.pop();
-            }
+LoggerService::Counters LoggerService::getCounters() const {
+    Counters counters;
+    counters.logged = logged.load(std::memory_order_relaxed);
+    counters.dropped = dropped.load(std::memory_order_relaxed);
+    counters.written = written.load(std::memory_order_relaxed);
+    return counters;
+}
 
-            if (!batch.empty()) {
-                json j = batch; // Relies on overloaded to_json for LogEvent
-                outFile << j.dump(4) << std::endl; // pretty print
-            }
+// Scheduler job: drains the ring into the log segments as one line of JSON per event (NDJSON)
+void LoggerService::flush() {
+    flushPending.store(false, std::memory_order_release); // later events arm the next flush
 
-            if (!running && eventQueue.empty()) {
-                break;
-            }
+    LogEvent event;
+    uint64_t count = 0;
+    try {
+        while (ring.tryPop(event)) {
+            segments.append(event.time, format(event));
+            ++count;
         }
+        segments.flush();
     }
     catch (const std::exception& ex) {
         std::cerr << "LoggerService exception: " << ex.what() << std::endl;
     }
+    written.fetch_add(count, std::memory_order_relaxed);
 }
 
-std::string LoggerService::getCurrentTime() const {
-    auto now = std::chrono::system_clock::now();
-    std::time_t time = std::chrono::system_clock::to_time_t(now);
-    std::tm* tm_ptr = std::localtime(&time);
+const std::string& LoggerService::format(const LogEvent& event) {
+    line = "{\"timestamp\":\"";
+    line += formatTimestamp(event.time);
+    line += "\",\"message\":";
+    line += json(event.message).dump(); // quotes and escapes
+    line += '}';
+    return line;
+}
 
-    std::ostringstream oss;
-    if (tm_ptr) {
-        oss << std::put_time(tm_ptr, "%Y-%m-%d %H:%M:%S");
-    }
-    return oss.str(); // Returns empty string if localtime fails  rare, but possible
+// Local "YYYY-MM-DD HH:MM:SS"; consecutive events mostly share a second, so the text is reused
+const std::string& LoggerService::formatTimestamp(std::chrono::system_clock::time_point time) {
+    std::time_t seconds = std::chrono::system_clock::to_time_t(time);
+    if (seconds == formattedSecond) return formattedTimestamp;
+
+    std::tm local{};
+#ifdef _WIN32
+    bool ok = localtime_s(&local, &seconds) == 0;
+#else
+    bool ok = localtime_r(&seconds, &local) != nullptr;
+#endif
+    char text[32];
+    size_t length = ok ? std::strftime(text, sizeof(text), "%Y-%m-%d %H:%M:%S", &local) : 0;
+    formattedTimestamp.assign(text, length); // empty if localtime fails — rare, but possible
+    formattedSecond = seconds;
+    return formattedTimestamp;
 }
\ No newline at end of file
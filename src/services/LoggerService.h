@@ -1,33 +1,58 @@
 #pragma once
 
 #include "LogEvent.h"
-#include <queue>
-#include <mutex>
-#include <condition_variable>
-#include <thread>
-#include <fstream>
+#include "MpscRing.h"
+#include "LogSegments.h"
+#include "Scheduler.h"
+#include <memory>
 #include <atomic>
+#include <ctime>
 
 class LoggerService {
 public:
-    LoggerService() = default;
-    LoggerService(const std::string& filename);
+    // What logEvent does when the ring is full: wait for the writer, or discard the event
+    enum class OverflowPolicy { Block, Drop };
+
+    struct Counters {
+        uint64_t logged = 0;  // accepted into the ring
+        uint64_t dropped = 0; // rejected because the ring was full (Drop policy, or logger stopped)
+        uint64_t written = 0; // written to the file
+        uint64_t queued() const { return logged - written; }
+    };
+
+    // Logs into size-capped segments under the given directory (see LogSegments.h)
+    LoggerService(const std::string& directory, std::shared_ptr<Scheduler> scheduler, LogSegmentLimits limits = {},
+        size_t capacity = 8192, OverflowPolicy policy = OverflowPolicy::Block);
     ~LoggerService();
 
     void start();
     void stop();
 
+    // Safe from any thread; takes no lock unless the ring is full
     void logEvent(const std::string& message);
+    Counters getCounters() const;
 
 private:
-    void processEvents();
-    std::string getCurrentTime() const;
+    void flush();
+    const std::string& format(const LogEvent& event);
+    const std::string& formatTimestamp(std::chrono::system_clock::time_point time);
 
 private:
-    std::string filename;
-    std::queue<LogEvent> eventQueue;
-    std::mutex mutex;
-    std::condition_variable condVar;
-    std::thread worker;
+    std::string directory;
+    std::shared_ptr<Scheduler> scheduler;
+    Scheduler::JobId flushJob = 0;
+    OverflowPolicy policy;
+    MpscRing<LogEvent> ring;
     std::atomic<bool> running;
+    std::atomic<bool> flushPending{ false }; // a flush is armed and will see events pushed before it starts
+
+    std::atomic<uint64_t> logged{ 0 };
+    std::atomic<uint64_t> dropped{ 0 };
+    std::atomic<uint64_t> written{ 0 };
+
+    // Written only by the flush job, or by stop() once it is cancelled
+    LogSegmentWriter segments;
+    std::string line;
+    std::time_t formattedSecond = -1;
+    std::string formattedTimestamp;
 };
\ No newline at end of file
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Bounded lock-free queue for many producers and one consumer (after D. Vyukov's
+// bounded MPMC queue). Each cell carries a sequence number telling producers and the
+// consumer whose turn it is, so a push is one CAS on the tail plus two stores.
+template <typename T>
+class MpscRing {
+public:
+    // Capacity is rounded up to a power of two
+    explicit MpscRing(size_t requested) {
+        size_t capacity = 2;
+        while (capacity < requested) capacity <<= 1;
+        mask = capacity - 1;
+        cells = std::make_unique<Cell[]>(capacity);
+        for (size_t i = 0; i < capacity; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    // Any thread. Returns false, leaving value untouched, if the ring is full.
+    bool tryPush(T&& value) {
+        size_t position = tail.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &cells[position & mask];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t lag = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (lag == 0) {
+                if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+            }
+            else if (lag < 0) {
+                return false; // the consumer has not freed this cell yet
+            }
+            else {
+                position = tail.load(std::memory_order_relaxed); // another producer took it
+            }
+        }
+        cell->value = std::move(value);
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer thread only. Returns false if nothing is ready.
+    bool tryPop(T& value) {
+        Cell& cell = cells[head & mask];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        if (static_cast<intptr_t>(sequence) - static_cast<intptr_t>(head + 1) < 0) return false;
+
+        value = std::move(cell.value);
+        cell.sequence.store(head + mask + 1, std::memory_order_release);
+        ++head;
+        return true;
+    }
+
+    size_t capacity() const { return mask + 1; }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    size_t mask = 0;
+    alignas(64) std::atomic<size_t> tail{ 0 }; // next position producers claim
+    alignas(64) size_t head = 0;               // next position the consumer reads
+};
\ No newline at end of file
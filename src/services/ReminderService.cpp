@@ -2,9 +2,11 @@
 #include <iostream>
 #include "DateTimeUtils.h"
 #include "ConsoleMutex.h"
+#include "TaskRenderer.h"
+#include "DeadlineKernels.h"
 
-ReminderService::ReminderService(std::shared_ptr<TaskManager> taskManager)
-    : running(false), taskManager(taskManager) {
+ReminderService::ReminderService(std::shared_ptr<TaskManager> taskManager, std::shared_ptr<Scheduler> scheduler)
+    : running(false), taskManager(taskManager), scheduler(scheduler) {
 }
 
 ReminderService::~ReminderService() {
@@ -15,33 +17,115 @@ ReminderService::~ReminderService() {
 void ReminderService::start() {
     if (running) return;
     running = true;
-    workerThread = std::thread(&ReminderService::run, this);
+    greeted = false;
+    tasksChanged = false;
+    wakeJob = scheduler->schedule("reminders", [this]() { wake(); });
+    listenerId = taskManager->addMutationListener([this]() {
+        tasksChanged = true;
+        scheduler->rearm(wakeJob); // Rebuild the timers right away
+        });
 }
 
 void ReminderService::stop() {
     if (!running) return;
     running = false;
-    cv.notify_all(); // Wakes up the thread if it's sleeping
-    if (workerThread.joinable())
-        workerThread.join();
+    taskManager->removeMutationListener(listenerId);
+    scheduler->cancel(wakeJob); // Waits for a wakeup that is already running
 }
 
 bool ReminderService::isRunning() const {
     return running;
 }
 
-void ReminderService::run() {
-    while (running) {
-        {
-            std::lock_guard<std::mutex> lock(consoleMutex); // Prevents output conflicts
-            taskManager->showUpcomingDeadlines(true); // Show tasks with deadlines in 48h
-            taskManager->showOverduedDeadlines(true); // Show overdue tasks
+// Prints the incomplete tasks of a view under a reminder header; returns whether any were printed
+bool ReminderService::printReminder(const char* header, const TaskView& view) {
+    bool found = false;
+    TaskRenderer renderer;
+    for (const auto& entry : view) {
+        if (entry.task.getCompleted()) continue;
+        if (!found) {
+            renderer.text("\n[Reminder] " + std::string(header) + " tasks:\n");
+            found = true;
         }
+        renderer.add(entry.task);
+        renderer.text("-----------------------------\n");
+    }
+    return found;
+}
+
+// Queues every future moment at which an incomplete task enters the 48h window or becomes overdue.
+// Built from one snapshot, so the queued positions stay valid until the next rebuild.
+void ReminderService::rebuildTimers(std::chrono::system_clock::time_point after) {
+    timerSnapshot = taskManager->snapshot();
+
+    // Only incomplete tasks due after `after` have a crossing left; one kernel pass selects them
+    const TaskTable& tasks = timerSnapshot->tasks;
+    std::vector<uint64_t> pending = tasks.selectIncompleteDue(TaskTable::toTicks(after) + 1, INT64_MAX);
+
+    std::vector<Crossing> crossings;
+    DeadlineKernels::forEachSelected(pending.data(), pending.size(), [&](size_t index) {
+        auto deadline = tasks.deadline(index);
+        auto windowStart = deadline - std::chrono::hours(48);
+        if (windowStart > after) crossings.push_back({ windowStart, Crossing::Kind::EntersWindow, index });
+        crossings.push_back({ deadline, Crossing::Kind::BecomesOverdue, index });
+    });
+    timers = CrossingQueue(std::greater<Crossing>(), std::move(crossings)); // heapified in O(n)
+}
+
+// Reports the crossings that have come due since the last wakeup.
+// Returns false, leaving them queued, if the console is busy with a command.
+bool ReminderService::fireDueTimers(std::chrono::system_clock::time_point now) {
+    std::unique_lock<std::mutex> lock(consoleMutex, std::try_to_lock); // Prevents output conflicts
+    if (!lock.owns_lock()) return false;
+
+    std::vector<size_t> upcoming;
+    std::vector<size_t> overdue;
+    while (!timers.empty() && timers.top().at <= now) {
+        const Crossing& crossing = timers.top();
+        (crossing.kind == Crossing::Kind::EntersWindow ? upcoming : overdue).push_back(crossing.index);
+        timers.pop();
+    }
+    firedUntil = now;
 
-        std::unique_lock<std::mutex> lock(cvMutex);
-        // Sleep for 60 seconds unless stop() is called
-        if (cv.wait_for(lock, std::chrono::seconds(60), [this]() { return !running; })) {
-            break;
+    bool printed = printReminder("Upcoming", TaskView::of(timerSnapshot->tasks, std::move(upcoming)));
+    printed = printReminder("Overdued", TaskView::of(timerSnapshot->tasks, std::move(overdue))) || printed;
+    if (printed) std::cout << ">";
+    return true;
+}
+
+// Scheduler job: lists everything pending once after start, then runs again at the next
+// crossing (or as soon as the tasks change) instead of rescanning on a fixed interval
+void ReminderService::wake() {
+    const auto consoleRetry = std::chrono::seconds(1);
+    auto now = std::chrono::system_clock::now();
+
+    if (!greeted) {
+        auto snapshot = taskManager->snapshot();
+        TaskView upcoming = snapshot->dueBetween(now, now + std::chrono::hours(48)); // Deadlines in 48h
+        TaskView overdue = snapshot->dueBefore(now);
+
+        std::unique_lock<std::mutex> lock(consoleMutex, std::try_to_lock);
+        if (!lock.owns_lock()) {
+            scheduler->rearm(wakeJob, consoleRetry);
+            return;
         }
+        printReminder("Upcoming", upcoming);
+        if (printReminder("Overdued", overdue)) std::cout << ">";
+        greeted = true;
+        firedUntil = now;
+        tasksChanged = false;
+        rebuildTimers(firedUntil);
+    }
+
+    // Crossings between the last wakeup and now still fire after a rebuild
+    if (tasksChanged.exchange(false)) rebuildTimers(firedUntil);
+    if (!timers.empty() && timers.top().at <= now && !fireDueTimers(now)) {
+        scheduler->rearm(wakeJob, consoleRetry);
+        return;
+    }
+
+    if (!timers.empty()) {
+        auto delay = timers.top().at - std::chrono::system_clock::now();
+        scheduler->rearm(wakeJob, std::chrono::ceil<Scheduler::Clock::duration>(delay));
     }
 }
\ No newline at end of file
@@ -1,14 +1,15 @@
 #pragma once
-#include <thread>
 #include <atomic>
 #include <chrono>
 #include <memory>
+#include <queue>
+#include <vector>
 #include "TaskManager.h"
-#include <condition_variable>
+#include "Scheduler.h"
 
 class ReminderService {
 public:
-    ReminderService(std::shared_ptr<TaskManager> taskManager);
+    ReminderService(std::shared_ptr<TaskManager> taskManager, std::shared_ptr<Scheduler> scheduler);
     ~ReminderService();
 
     void start();
@@ -17,11 +18,34 @@ public:
     bool isRunning() const;
 
 private:
-    void run();
+    // A moment at which a task's reminder state changes
+    struct Crossing {
+        enum class Kind { EntersWindow, BecomesOverdue };
+
+        std::chrono::system_clock::time_point at;
+        Kind kind;
+        size_t index; // position in the snapshot the timers were built from
+
+        bool operator>(const Crossing& other) const { return at > other.at; }
+    };
+    using CrossingQueue = std::priority_queue<Crossing, std::vector<Crossing>, std::greater<Crossing>>;
+
+    void wake();
+    void rebuildTimers(std::chrono::system_clock::time_point after);
+    bool fireDueTimers(std::chrono::system_clock::time_point now);
+    static bool printReminder(const char* header, const TaskView& view);
 
-    std::thread workerThread;
     std::atomic<bool> running;
     std::shared_ptr<TaskManager> taskManager;
-    std::mutex cvMutex;
-    std::condition_variable cv;
+    std::shared_ptr<Scheduler> scheduler;
+    Scheduler::JobId wakeJob = 0;
+
+    // Only touched by the wake job, which the scheduler never runs twice at once
+    std::shared_ptr<const TaskSnapshot> timerSnapshot;
+    CrossingQueue timers;
+    std::chrono::system_clock::time_point firedUntil; // crossings up to here were already reported
+    bool greeted = false;                             // pending tasks were listed once after start
+
+    std::atomic<bool> tasksChanged{ false }; // set by the TaskManager mutation listener
+    size_t listenerId = 0;
 };
\ No newline at end of file
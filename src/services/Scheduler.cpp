@@ -0,0 +1,190 @@
+#include "Scheduler.h"
+#include <algorithm>
+#include <iostream>
+#include <memory>
+
+Scheduler::Scheduler(size_t workerCount)
+    : workerCount(workerCount == 0 ? 1 : workerCount) {
+}
+
+Scheduler::~Scheduler() {
+    stop();
+}
+
+void Scheduler::start() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (running) return;
+    running = true;
+    for (size_t i = 0; i < workerCount; ++i) {
+        workers.emplace_back(&Scheduler::workerLoop, this);
+    }
+}
+
+void Scheduler::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!running) return;
+        running = false;
+    }
+    wakeup.notify_all();
+    for (auto& worker : workers) {
+        if (worker.joinable()) worker.join();
+    }
+    workers.clear();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    jobs.clear();
+    timers = {};
+    finished.notify_all();
+}
+
+Scheduler::JobId Scheduler::add(Entry entry, Clock::time_point due) {
+    JobId id;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        id = nextId++;
+        arm(id, jobs.emplace(id, std::move(entry)).first->second, due);
+    }
+    wakeup.notify_one();
+    return id;
+}
+
+// Caller holds the mutex. A running job is queued again once its run finishes.
+void Scheduler::arm(JobId id, Entry& entry, Clock::time_point due) {
+    if (entry.due && *entry.due <= due) return;
+    entry.due = due;
+    if (!entry.running) timers.push({ due, id });
+}
+
+Scheduler::JobId Scheduler::schedule(const std::string& name, Job job, Clock::duration delay) {
+    Entry entry;
+    entry.name = name;
+    entry.job = std::move(job);
+    return add(std::move(entry), Clock::now() + delay);
+}
+
+Scheduler::JobId Scheduler::schedulePeriodic(const std::string& name, Job job, Clock::duration interval) {
+    Entry entry;
+    entry.name = name;
+    entry.job = std::move(job);
+    entry.interval = interval;
+    return add(std::move(entry), Clock::now() + interval);
+}
+
+void Scheduler::rearm(JobId id, Clock::duration delay) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = jobs.find(id);
+        if (it == jobs.end() || it->second.cancelled) return;
+        arm(id, it->second, Clock::now() + std::max(delay, Clock::duration::zero()));
+    }
+    wakeup.notify_one();
+}
+
+void Scheduler::cancel(JobId id) {
+    std::unique_lock<std::mutex> lock(mutex);
+    auto it = jobs.find(id);
+    if (it == jobs.end()) return;
+
+    if (!it->second.running) {
+        jobs.erase(it); // its queued timer goes stale
+        return;
+    }
+
+    // Running: the worker unregisters it when the run ends
+    it->second.cancelled = true;
+    if (it->second.runner == std::this_thread::get_id()) return; // cancelled from inside its own run
+    finished.wait(lock, [this, id]() { return jobs.find(id) == jobs.end(); });
+}
+
+std::future<void> Scheduler::submit(const std::string& name, Job job) {
+    auto task = std::make_shared<std::packaged_task<void()>>(std::move(job));
+    std::future<void> result = task->get_future();
+
+    Entry entry;
+    entry.name = name;
+    entry.job = [task]() { (*task)(); };
+    entry.transient = true;
+    add(std::move(entry), Clock::now());
+    return result;
+}
+
+void Scheduler::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (running) {
+        if (timers.empty()) {
+            wakeup.wait(lock);
+            continue;
+        }
+
+        Pending next = timers.top();
+        auto it = jobs.find(next.id);
+        if (it == jobs.end() || it->second.running || !it->second.due || *it->second.due != next.due) {
+            timers.pop(); // stale; a running job is queued again when it finishes
+            continue;
+        }
+        if (next.due > Clock::now()) {
+            wakeup.wait_until(lock, next.due);
+            continue;
+        }
+
+        timers.pop();
+        Entry& entry = it->second;
+        entry.due.reset();
+        entry.running = true;
+        entry.runner = std::this_thread::get_id();
+        if (!timers.empty()) wakeup.notify_one(); // more work may be due for an idle worker
+
+        lock.unlock();
+        auto started = Clock::now();
+        try {
+            entry.job();
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Scheduler job '" << entry.name << "' failed: " << e.what() << '\n';
+        }
+        catch (...) {
+            std::cerr << "Scheduler job '" << entry.name << "' failed: unknown exception\n";
+        }
+        auto ended = Clock::now();
+        lock.lock();
+
+        JobStats& jobStats = stats[entry.name];
+        jobStats.name = entry.name;
+        jobStats.runs++;
+        jobStats.totalRunTime += ended - started;
+        jobStats.maxRunTime = std::max(jobStats.maxRunTime, ended - started);
+        jobStats.totalQueueDelay += started - next.due;
+        jobStats.maxQueueDelay = std::max(jobStats.maxQueueDelay, started - next.due);
+
+        entry.running = false;
+        if (entry.cancelled || entry.transient) {
+            jobs.erase(it);
+            finished.notify_all();
+            continue;
+        }
+
+        std::optional<Clock::time_point> rearmed = entry.due; // re-armed while it was running
+        entry.due.reset();
+        if (rearmed) arm(next.id, entry, *rearmed);
+        if (entry.interval > Clock::duration::zero()) {
+            auto due = next.due + entry.interval;
+            if (due <= ended) due += ((ended - due) / entry.interval + 1) * entry.interval;
+            arm(next.id, entry, due);
+        }
+    }
+}
+
+std::vector<Scheduler::JobStats> Scheduler::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<JobStats> result;
+    result.reserve(stats.size());
+    for (const auto& entry : stats) {
+        result.push_back(entry.second);
+    }
+    return result;
+}
+
+size_t Scheduler::getWorkerCount() const {
+    return workerCount;
+}
\ No newline at end of file
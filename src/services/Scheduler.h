@@ -0,0 +1,92 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Runs the background services' work on a small shared pool of threads.
+// Jobs are kept in one timer queue ordered by due time; any idle worker picks up
+// the earliest due job. A job never runs on two workers at once.
+class Scheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+    using JobId = uint64_t;
+    using Job = std::function<void()>;
+
+    // Timing totals per job name
+    struct JobStats {
+        std::string name;
+        uint64_t runs = 0;
+        Clock::duration totalRunTime{ 0 };
+        Clock::duration maxRunTime{ 0 };
+        Clock::duration totalQueueDelay{ 0 }; // due time -> start of the run
+        Clock::duration maxQueueDelay{ 0 };
+    };
+
+    explicit Scheduler(size_t workerCount = 2);
+    ~Scheduler();
+
+    void start();
+    // Drops every remaining job and joins the workers; futures of unfinished submits become broken
+    void stop();
+
+    // One-shot job due after the delay. It stays registered after running, so it can be re-armed.
+    JobId schedule(const std::string& name, Job job, Clock::duration delay = Clock::duration::zero());
+    // Job due every interval (measured between due times; missed runs are skipped, not queued up)
+    JobId schedulePeriodic(const std::string& name, Job job, Clock::duration interval);
+    // Makes a registered job due after the delay, unless it is already due sooner
+    void rearm(JobId id, Clock::duration delay = Clock::duration::zero());
+    // Unregisters a job; if it is running on another thread, waits for that run to finish
+    void cancel(JobId id);
+
+    // Runs a job once, as soon as a worker is free
+    std::future<void> submit(const std::string& name, Job job);
+
+    std::vector<JobStats> getStats() const;
+    size_t getWorkerCount() const;
+
+private:
+    struct Entry {
+        std::string name;
+        Job job;
+        Clock::duration interval{ 0 };       // zero for one-shot jobs
+        std::optional<Clock::time_point> due; // set while armed
+        bool transient = false;               // submitted work: unregistered after one run
+        bool running = false;
+        bool cancelled = false;
+        std::thread::id runner;
+    };
+
+    struct Pending {
+        Clock::time_point due;
+        JobId id;
+        bool operator>(const Pending& other) const { return due > other.due; }
+    };
+
+    void workerLoop();
+    void arm(JobId id, Entry& entry, Clock::time_point due);
+    JobId add(Entry entry, Clock::time_point due);
+
+    size_t workerCount;
+    std::vector<std::thread> workers;
+    bool running = false;
+
+    mutable std::mutex mutex;
+    std::condition_variable wakeup;   // the timer queue changed, or stop
+    std::condition_variable finished; // a job run finished (for cancel)
+
+    std::map<JobId, Entry> jobs;
+    // Lazily pruned: an item is stale once its job is gone or re-armed to another time
+    std::priority_queue<Pending, std::vector<Pending>, std::greater<Pending>> timers;
+    JobId nextId = 1;
+    std::map<std::string, JobStats> stats;
+};
\ No newline at end of file
@@ -1,52 +1,273 @@
 #include "DateTimeUtils.h"
-#include <sstream>
-#include <iomanip>
 #include <stdexcept>
 #include <ctime>
+#include <unordered_map>
+
+// Deadlines are stored as local *standard* time: parsing treats the text as if DST were not
+// in effect, and formatting subtracts an hour while DST is active. The parser and formatter
+// below keep that convention but do the calendar arithmetic themselves, asking the C library
+// only for the zone's UTC offset, which is cached per UTC day (and per thread, so no locks).
+
+namespace {
+    constexpr int64_t secondsPerDay = 86400;
+
+    // The zone rules are read once, before any thread calls localtime_r
+    void loadTimeZone() {
+        static const bool loaded = []() {
+#ifdef _WIN32
+            _tzset();
+#else
+            tzset();
+#endif
+            return true;
+        }();
+        (void)loaded;
+    }
+
+    bool toLocalTm(std::time_t time, std::tm& out) {
+        loadTimeZone();
+#ifdef _WIN32
+        return localtime_s(&out, &time) == 0;
+#else
+        return localtime_r(&time, &out) != nullptr;
+#endif
+    }
+
+    // Days since 1970-01-01 of a proleptic Gregorian date (H. Hinnant's algorithm).
+    // Out-of-range days simply carry over, like mktime does (e.g. Feb 30 -> Mar 2).
+    int64_t daysFromCivil(int64_t year, unsigned month, int64_t day) {
+        year -= month <= 2;
+        const int64_t era = (year >= 0 ? year : year - 399) / 400;
+        const int64_t yearOfEra = year - era * 400;
+        const int64_t dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+        const int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        return era * 146097 + dayOfEra - 719468;
+    }
+
+    void civilFromDays(int64_t days, int64_t& year, unsigned& month, unsigned& day) {
+        days += 719468;
+        const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+        const int64_t dayOfEra = days - era * 146097;
+        const int64_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+        const int64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+        const int64_t monthIndex = (5 * dayOfYear + 2) / 153;
+        day = static_cast<unsigned>(dayOfYear - (153 * monthIndex + 2) / 5 + 1);
+        month = static_cast<unsigned>(monthIndex < 10 ? monthIndex + 3 : monthIndex - 9);
+        year = yearOfEra + era * 400 + (month <= 2);
+    }
+
+    int64_t floorDiv(int64_t value, int64_t divisor) {
+        return value / divisor - (value % divisor < 0 ? 1 : 0);
+    }
+
+    struct ZoneOffset {
+        int64_t utcOffset = 0; // seconds east of UTC
+        bool dst = false;
+    };
+
+    ZoneOffset zoneOffsetUncached(std::time_t time) {
+        std::tm local{};
+        ZoneOffset offset;
+        if (!toLocalTm(time, local)) return offset;
+
+        // Offset = local wall clock read as UTC, minus the instant itself
+        const int64_t days = daysFromCivil(local.tm_year + 1900LL, local.tm_mon + 1, local.tm_mday);
+        offset.utcOffset = days * secondsPerDay + local.tm_hour * 3600 + local.tm_min * 60 + local.tm_sec - time;
+        offset.dst = local.tm_isdst > 0;
+        return offset;
+    }
+
+    // Zone offset at an instant. A UTC day whose offset is the same at both ends is assumed
+    // to have no transition in between and is answered from the cache; the few transition
+    // days go to the C library every time.
+    ZoneOffset zoneOffsetAt(int64_t time) {
+        struct DayOffsets {
+            ZoneOffset start;
+            ZoneOffset end;
+        };
+        thread_local std::unordered_map<int64_t, DayOffsets> cache;
+
+        const int64_t day = floorDiv(time, secondsPerDay);
+        auto it = cache.find(day);
+        if (it == cache.end()) {
+            if (cache.size() > 4096) cache.clear();
+            DayOffsets offsets{ zoneOffsetUncached(static_cast<std::time_t>(day * secondsPerDay)),
+                zoneOffsetUncached(static_cast<std::time_t>(day * secondsPerDay + secondsPerDay - 1)) };
+            it = cache.emplace(day, offsets).first;
+        }
+
+        const DayOffsets& offsets = it->second;
+        if (offsets.start.utcOffset == offsets.end.utcOffset && offsets.start.dst == offsets.end.dst) {
+            return offsets.start;
+        }
+        return zoneOffsetUncached(static_cast<std::time_t>(time));
+    }
+
+    // Offset the zone has outside DST around an instant. Like mktime, looks for the nearest
+    // non-DST time in steps of about a week, and remembers the answer per UTC day.
+    int64_t standardOffsetAt(int64_t time) {
+        ZoneOffset offset = zoneOffsetAt(time);
+        if (!offset.dst) return offset.utcOffset;
+
+        thread_local std::unordered_map<int64_t, int64_t> cache;
+        const int64_t day = floorDiv(time, secondsPerDay);
+        auto it = cache.find(day);
+        if (it != cache.end()) return it->second;
+        if (cache.size() > 4096) cache.clear();
+
+        const int64_t stride = 601200;
+        int64_t standard = offset.utcOffset - 3600;
+        for (int64_t delta = stride; delta < 536454000 / 2 + stride; delta += stride) {
+            ZoneOffset before = zoneOffsetAt(time - delta);
+            if (!before.dst) { standard = before.utcOffset; break; }
+            ZoneOffset after = zoneOffsetAt(time + delta);
+            if (!after.dst) { standard = after.utcOffset; break; }
+        }
+        cache.emplace(day, standard);
+        return standard;
+    }
+
+    bool isSpace(char c) {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+    }
+
+    // Reads 1..maxDigits digits into value and checks its range
+    bool readNumber(const std::string& text, size_t& pos, int maxDigits, int minValue, int maxValue, int& value) {
+        if (pos >= text.size() || text[pos] < '0' || text[pos] > '9') return false;
+        value = 0;
+        for (int digits = 0; digits < maxDigits && pos < text.size() && text[pos] >= '0' && text[pos] <= '9'; ++digits) {
+            value = value * 10 + (text[pos++] - '0');
+        }
+        return value >= minValue && value <= maxValue;
+    }
+
+    // Fixed-format "YYYY-MM-DD HH:MM[:SS]" parser. Mirrors what get_time accepted before:
+    // leading whitespace, 1-2 digit fields, any whitespace between date and time, one space
+    // before the day, input may stop before any separator, and anything after the seconds is ignored.
+    bool parseFields(const std::string& text, int& year, int& month, int& day, int& hour, int& minute, int& second) {
+        size_t pos = 0;
+        while (pos < text.size() && isSpace(text[pos])) ++pos;
+
+        year = 1900; month = 1; day = 0; hour = 0; minute = 0; second = 0; // what an absent field meant to mktime
+        if (!readNumber(text, pos, 4, 0, 9999, year)) return false;
+
+        if (pos == text.size()) return true;
+        if (text[pos++] != '-' || !readNumber(text, pos, 2, 1, 12, month)) return false;
+
+        if (pos == text.size()) return true;
+        if (text[pos++] != '-') return false;
+        if (pos < text.size() && text[pos] == ' ') ++pos;
+        if (!readNumber(text, pos, 2, 1, 31, day)) return false;
+
+        if (pos == text.size()) return true;
+        while (pos < text.size() && isSpace(text[pos])) ++pos;
+        if (!readNumber(text, pos, 2, 0, 23, hour)) return false;
+
+        if (pos == text.size()) return true;
+        if (text[pos++] != ':' || !readNumber(text, pos, 2, 0, 59, minute)) return false;
+
+        if (pos == text.size()) return true;
+        return text[pos++] == ':' && readNumber(text, pos, 2, 0, 60, second);
+    }
+
+    void appendDigits(std::string& out, int64_t value, int width) {
+        char digits[24];
+        int length = 0;
+        bool negative = value < 0;
+        uint64_t magnitude = negative ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+        do {
+            digits[length++] = static_cast<char>('0' + magnitude % 10);
+            magnitude /= 10;
+        } while (magnitude > 0);
+        if (negative) out += '-';
+        for (int i = length; i < width; ++i) out += '0';
+        while (length > 0) out += digits[--length];
+    }
+}
 
 namespace DateTimeUtils {
     // Converts time_point to string (format: YYYY-MM-DD HH:MM:SS)
-    // Handles daylight saving time (DST) by subtracting one hour if active
     std::string timePointToString(const std::chrono::system_clock::time_point& timePoint) {
-        std::time_t time = std::chrono::system_clock::to_time_t(timePoint);
-        std::tm* tm_ptr = std::localtime(&time);
+        std::string out;
+        out.reserve(19);
+        appendTimePoint(out, timePoint);
+        return out;
+    }
 
-        if (tm_ptr && tm_ptr->tm_isdst > 0) {
+    // Handles daylight saving time (DST) by subtracting one hour if active
+    void appendTimePoint(std::string& out, const std::chrono::system_clock::time_point& timePoint, bool withSeconds) {
+        int64_t time = toEpochSeconds(timePoint);
+        ZoneOffset offset = zoneOffsetAt(time);
+        if (offset.dst) {
             time -= 3600;  // subtract one hour for DST
-            tm_ptr = std::localtime(&time);
+            offset = zoneOffsetAt(time);
         }
 
-        std::ostringstream oss;
-        if (tm_ptr) {
-            oss << std::put_time(tm_ptr, "%Y-%m-%d %H:%M:%S");
+        const int64_t local = time + offset.utcOffset;
+        const int64_t days = floorDiv(local, secondsPerDay);
+        const int64_t secondOfDay = local - days * secondsPerDay;
+        int64_t year;
+        unsigned month, day;
+        civilFromDays(days, year, month, day);
+
+        appendDigits(out, year, 4);
+        out += '-';
+        appendDigits(out, month, 2);
+        out += '-';
+        appendDigits(out, day, 2);
+        out += ' ';
+        appendDigits(out, secondOfDay / 3600, 2);
+        out += ':';
+        appendDigits(out, secondOfDay / 60 % 60, 2);
+        if (withSeconds) {
+            out += ':';
+            appendDigits(out, secondOfDay % 60, 2);
         }
-        return oss.str();
     }
 
-    // Parses string (YYYY-MM-DD HH:MM:SS) into time_point
+    // Parses string (YYYY-MM-DD HH:MM:SS) into time_point, as local standard time.
+    // Seconds are accepted but dropped.
     std::chrono::system_clock::time_point stringToTimePoint(const std::string& datetimeStr) {
-        std::tm tm = {};
-        std::istringstream ss(datetimeStr);
-        ss >> std::get_time(&tm, "%Y-%m-%d %H:%M:%S");
-
-        if (ss.fail()) {
+        int year, month, day, hour, minute, second;
+        if (!parseFields(datetimeStr, year, month, day, hour, minute, second)) {
             throw std::runtime_error("Failed to parse datetime string: " + datetimeStr);
         }
-        tm.tm_sec = 0; // explicitly set seconds
 
-        std::time_t time = std::mktime(&tm);
-        if (time == -1) {
-            throw std::runtime_error("Invalid time value: " + datetimeStr);
+        const int64_t local = daysFromCivil(year, static_cast<unsigned>(month), day) * secondsPerDay + hour * 3600 + minute * 60;
+        // Find the instant showing this wall clock time, then reinterpret it in standard time
+        int64_t time = local - zoneOffsetAt(local).utcOffset;
+        time = local - zoneOffsetAt(time).utcOffset;
+        return fromEpochSeconds(local - standardOffsetAt(time));
+    }
+
+    // Same text, read as the plain local wall clock (DST included) and keeping the seconds,
+    // the way strftime/localtime write it, e.g. in the log
+    std::chrono::system_clock::time_point wallClockStringToTimePoint(const std::string& datetimeStr) {
+        int year, month, day, hour, minute, second;
+        if (!parseFields(datetimeStr, year, month, day, hour, minute, second)) {
+            throw std::runtime_error("Failed to parse datetime string: " + datetimeStr);
         }
 
-        return std::chrono::system_clock::from_time_t(time);
+        const int64_t local = daysFromCivil(year, static_cast<unsigned>(month), day) * secondsPerDay +
+            hour * 3600 + minute * 60 + second;
+        int64_t time = local - zoneOffsetAt(local).utcOffset;
+        return fromEpochSeconds(local - zoneOffsetAt(time).utcOffset);
+    }
+
+    int64_t toEpochSeconds(std::chrono::system_clock::time_point timePoint) {
+        return std::chrono::duration_cast<std::chrono::seconds>(timePoint.time_since_epoch()).count();
+    }
+
+    std::chrono::system_clock::time_point fromEpochSeconds(int64_t seconds) {
+        return std::chrono::system_clock::time_point(std::chrono::seconds(seconds));
     }
 
 
     // Returns the beginning of the day (00:00:00) for a given time_point
     std::chrono::system_clock::time_point startOfDay(std::chrono::system_clock::time_point tp) {
         std::time_t tt = std::chrono::system_clock::to_time_t(tp);
-        std::tm local_tm = *std::localtime(&tt);
+        std::tm local_tm{};
+        toLocalTm(tt, local_tm);
         local_tm.tm_hour = 0;
         local_tm.tm_min = 0;
         local_tm.tm_sec = 0;
@@ -56,7 +277,8 @@ namespace DateTimeUtils {
     // Returns the end of the day (23:59:59) for a given time_point
     std::chrono::system_clock::time_point endOfDay(std::chrono::system_clock::time_point tp) {
         std::time_t tt = std::chrono::system_clock::to_time_t(tp);
-        std::tm local_tm = *std::localtime(&tt);
+        std::tm local_tm{};
+        toLocalTm(tt, local_tm);
         local_tm.tm_hour = 23;
         local_tm.tm_min = 59;
         local_tm.tm_sec = 59;
@@ -1,10 +1,18 @@
 #pragma once
 #include <string>
 #include <chrono>
+#include <cstdint>
 
 namespace DateTimeUtils {
     std::string timePointToString(const std::chrono::system_clock::time_point& timePoint);
+    // Same text appended to out, optionally without the seconds; allocation-free once out has capacity
+    void appendTimePoint(std::string& out, const std::chrono::system_clock::time_point& timePoint, bool withSeconds = true);
     std::chrono::system_clock::time_point stringToTimePoint(const std::string& datetimeStr);
+    // Plain local time with seconds, as localtime/strftime write it (log timestamps); throws std::runtime_error
+    std::chrono::system_clock::time_point wallClockStringToTimePoint(const std::string& datetimeStr);
+    // Compact deadline encoding: whole seconds since the Unix epoch, with no time zone involved
+    int64_t toEpochSeconds(std::chrono::system_clock::time_point timePoint);
+    std::chrono::system_clock::time_point fromEpochSeconds(int64_t seconds);
     std::chrono::system_clock::time_point startOfDay(std::chrono::system_clock::time_point tp);
     std::chrono::system_clock::time_point endOfDay(std::chrono::system_clock::time_point tp);
     std::string getCurrnetTime();
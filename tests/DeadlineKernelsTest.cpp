@@ -0,0 +1,126 @@
+#include "TestHarness.h"
+#include "DeadlineKernels.h"
+#include "TaskTable.h"
+#include <chrono>
+#include <random>
+#include <vector>
+
+// Every kernel level against the branchy per-task loop the kernels replace
+
+namespace {
+    using DeadlineKernels::Level;
+
+    const Level levels[] = { Level::Scalar, Level::Sse2, Level::Avx2 };
+
+    size_t referenceCount(const std::vector<int64_t>& deadlines, const std::vector<uint64_t>& completed,
+        size_t count, int64_t from, int64_t to, std::vector<uint64_t>& selected) {
+        size_t total = 0;
+        for (size_t i = 0; i < count; ++i) {
+            bool done = (completed[i / 64] >> (i % 64)) & 1;
+            if (!done && deadlines[i] >= from && deadlines[i] <= to) {
+                ++total;
+                selected[i / 64] |= uint64_t(1) << (i % 64);
+            }
+        }
+        return total;
+    }
+
+    // Compares count and select at every supported level with the reference on the first n rows
+    void checkAllLevels(const std::vector<int64_t>& deadlines, const std::vector<uint64_t>& completed,
+        size_t n, int64_t from, int64_t to) {
+        std::vector<uint64_t> expectedBits((n + 63) / 64);
+        size_t expected = referenceCount(deadlines, completed, n, from, to, expectedBits);
+
+        for (Level level : levels) {
+            if (!DeadlineKernels::isSupported(level)) continue;
+            std::vector<uint64_t> bits((n + 63) / 64, ~uint64_t(0)); // stale bits must be cleared
+            size_t counted = DeadlineKernels::countIncompleteDue(level, deadlines.data(), completed.data(), n, from, to);
+            size_t selected = DeadlineKernels::selectIncompleteDue(level, deadlines.data(), completed.data(), n, from, to, bits.data());
+            CHECK_EQ(counted, expected);
+            CHECK_EQ(selected, expected);
+            CHECK(bits == expectedBits);
+        }
+    }
+
+    // Rows past count are never marked completed, as in TaskTable
+    std::vector<uint64_t> completedMask(size_t count, uint64_t pattern) {
+        std::vector<uint64_t> words((count + 63) / 64, pattern);
+        if (count % 64 != 0) words.back() &= (uint64_t(1) << (count % 64)) - 1;
+        return words;
+    }
+
+    const int64_t now = TaskTable::toTicks(std::chrono::system_clock::now());
+    const int64_t hour = TaskTable::toTicks(std::chrono::system_clock::time_point(std::chrono::hours(1)));
+}
+
+TEST_CASE(deadline_kernels, scalar_is_always_supported) {
+    CHECK(DeadlineKernels::isSupported(Level::Scalar));
+    CHECK(DeadlineKernels::isSupported(DeadlineKernels::bestLevel()));
+}
+
+TEST_CASE(deadline_kernels, empty_input) {
+    std::vector<int64_t> deadlines;
+    std::vector<uint64_t> completed;
+    for (Level level : levels) {
+        if (!DeadlineKernels::isSupported(level)) continue;
+        CHECK_EQ(DeadlineKernels::countIncompleteDue(level, deadlines.data(), completed.data(), 0, INT64_MIN, INT64_MAX), size_t(0));
+        CHECK_EQ(DeadlineKernels::selectIncompleteDue(level, deadlines.data(), completed.data(), 0, INT64_MIN, INT64_MAX, nullptr), size_t(0));
+    }
+}
+
+// Deadlines exactly on both ends of the 48-hour window and one tick outside them
+TEST_CASE(deadline_kernels, window_boundaries_are_inclusive) {
+    const int64_t end = now + 48 * hour;
+    const std::vector<int64_t> deadlines = { now - 1, now, now + 1, end - 1, end, end + 1, now, end, now - hour, end + hour, now };
+    const std::vector<uint64_t> none = completedMask(deadlines.size(), 0);
+
+    std::vector<uint64_t> bits(1);
+    for (Level level : levels) {
+        if (!DeadlineKernels::isSupported(level)) continue;
+        CHECK_EQ(DeadlineKernels::countIncompleteDue(level, deadlines.data(), none.data(), deadlines.size(), now, end), size_t(7));
+        CHECK_EQ(DeadlineKernels::selectIncompleteDue(level, deadlines.data(), none.data(), deadlines.size(), now, end, bits.data()), size_t(7));
+        CHECK_EQ(bits[0], uint64_t(0b10011011110));
+    }
+    checkAllLevels(deadlines, none, deadlines.size(), now, end);
+    checkAllLevels(deadlines, none, deadlines.size(), now, now);   // single point
+    checkAllLevels(deadlines, none, deadlines.size(), end, now);   // empty window
+}
+
+// Every length from 0 to 200 (so every tail after the 4- and 8-wide blocks) and a few
+// long odd ones, with no, all, alternating and random completion bits
+TEST_CASE(deadline_kernels, tails_and_completion_masks) {
+    std::mt19937_64 random(23);
+    const size_t maximum = 4099;
+    std::vector<int64_t> deadlines(maximum);
+    for (auto& deadline : deadlines) {
+        deadline = now + static_cast<int64_t>(random() % (24 * 8)) * hour - 24 * 4 * hour;
+    }
+    deadlines[5] = now;
+    deadlines[6] = now + 48 * hour;
+
+    std::vector<size_t> lengths;
+    for (size_t n = 0; n <= 200; ++n) lengths.push_back(n);
+    for (size_t n : { 255, 257, 1021, 1027, 4097, 4099 }) lengths.push_back(n);
+
+    for (uint64_t pattern : { uint64_t(0), ~uint64_t(0), uint64_t(0xAAAAAAAAAAAAAAAA), uint64_t(random()) }) {
+        for (size_t n : lengths) {
+            std::vector<uint64_t> completed = completedMask(n, pattern);
+            checkAllLevels(deadlines, completed, n, now, now + 48 * hour);
+            checkAllLevels(deadlines, completed, n, INT64_MIN, now - 1);
+        }
+    }
+}
+
+// A signed/unsigned mix-up in the window test would miscount these
+TEST_CASE(deadline_kernels, int64_extremes) {
+    const std::vector<int64_t> deadlines = { INT64_MIN, INT64_MAX, 0, -1, 1, now, INT64_MIN + 1, INT64_MAX - 1, now + 48 * hour };
+    const std::vector<uint64_t> none = completedMask(deadlines.size(), 0);
+    const std::pair<int64_t, int64_t> windows[] = {
+        { INT64_MIN, INT64_MAX }, { INT64_MIN, now - 1 }, { now + 1, INT64_MAX }, { -1, 1 },
+        { INT64_MIN, INT64_MIN }, { INT64_MAX, INT64_MAX }, { now, now + 48 * hour } };
+    for (const auto& window : windows) {
+        for (size_t n = 0; n <= deadlines.size(); ++n) {
+            checkAllLevels(deadlines, none, n, window.first, window.second);
+        }
+    }
+}
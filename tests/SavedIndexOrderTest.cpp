@@ -0,0 +1,155 @@
+#include "TestHarness.h"
+#include "TaskManager.h"
+#include "BinaryStorage.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+// A snapshot load rebuilds the ordered indexes from the saved orders; they must come out the
+// same as a sort would, and a damaged order must be sorted again rather than trusted
+
+namespace {
+    namespace fs = std::filesystem;
+
+    struct ScratchDir {
+        fs::path path;
+        explicit ScratchDir(const std::string& name)
+            : path(fs::temp_directory_path() / ("task_manager_tests_" + name)) {
+            fs::remove_all(path);
+            fs::create_directories(path);
+        }
+        ~ScratchDir() {
+            std::error_code ec;
+            fs::remove_all(path, ec);
+        }
+        std::string file(const std::string& name) const { return (path / name).string(); }
+    };
+
+    const std::chrono::system_clock::time_point start = std::chrono::system_clock::now();
+
+    Task makeTask(int number) {
+        return Task("task " + std::to_string(number), "details", start + std::chrono::hours(number % 50),
+            static_cast<Priority>(number % 3), number % 2 ? "work" : "home", number % 7 == 0);
+    }
+
+    // Ids in deadline order; equal deadlines keep their index order
+    std::vector<TaskId> deadlineWalk(const TaskManager& manager) {
+        std::vector<TaskId> walk;
+        for (const auto& entry : manager.getDeadlineIndex()) walk.push_back(manager.getTaskByIndex(entry.second).getId());
+        return walk;
+    }
+
+    std::vector<TaskId> priorityWalk(const TaskManager& manager) {
+        std::vector<TaskId> walk;
+        for (const auto& entry : manager.getPriorityIndex()) walk.push_back(manager.getTaskByIndex(entry.second).getId());
+        return walk;
+    }
+
+    // Deadlines along the index, checked against each row's own
+    bool deadlineIndexSorted(const TaskManager& manager) {
+        const auto& index = manager.getDeadlineIndex();
+        if (index.size() != manager.getTaskCount()) return false;
+        for (const auto& entry : index) {
+            if (manager.getTaskByIndex(entry.second).getDeadline() != entry.first) return false;
+        }
+        return true;
+    }
+
+    // A saved manager with removes and edits behind it, so rows are out of id order
+    std::vector<TaskId> fillAndSave(const std::string& file, TaskManager& manager) {
+        manager.loadTasks(file);
+        std::vector<TaskId> ids;
+        for (int i = 0; i < 4000; ++i) ids.push_back(manager.addTask(makeTask(i)));
+        std::mt19937_64 random(5);
+        for (int i = 0; i < 1000; ++i) {
+            size_t pick = random() % ids.size();
+            if (i % 3 == 0) {
+                manager.editTask(ids[pick], makeTask(i * 11));
+                continue;
+            }
+            manager.removeTask(ids[pick]);
+            ids[pick] = ids.back();
+            ids.pop_back();
+        }
+        manager.saveTasks(file);
+        return ids;
+    }
+}
+
+TEST_CASE(saved_orders, reload_matches_the_saved_indexes) {
+    ScratchDir dir("saved_orders_reload");
+    const std::string file = dir.file("tasks.snap");
+    TaskManager saved;
+    fillAndSave(file, saved);
+
+    TaskManager reopened;
+    reopened.loadTasks(file);
+    CHECK(deadlineIndexSorted(reopened));
+    CHECK(deadlineWalk(reopened) == deadlineWalk(saved));
+    CHECK(priorityWalk(reopened) == priorityWalk(saved));
+}
+
+// Overwrites the priority order with a rotation of itself: every row once, but out of order
+TEST_CASE(saved_orders, damaged_order_is_sorted_again) {
+    ScratchDir dir("saved_orders_damaged");
+    const std::string file = dir.file("tasks.snap");
+    TaskManager saved;
+    fillAndSave(file, saved);
+
+    SnapshotHeader header{};
+    std::vector<uint32_t> order;
+    {
+        std::ifstream in(file, std::ios::binary);
+        in.read(reinterpret_cast<char*>(&header), sizeof(header));
+        CHECK(header.priorityOrderOffset != 0);
+        order.resize(header.count);
+        in.seekg(static_cast<std::streamoff>(header.priorityOrderOffset));
+        in.read(reinterpret_cast<char*>(order.data()), static_cast<std::streamsize>(order.size() * sizeof(uint32_t)));
+    }
+    std::rotate(order.begin(), order.begin() + 1, order.end());
+    {
+        std::fstream out(file, std::ios::binary | std::ios::in | std::ios::out);
+        out.seekp(static_cast<std::streamoff>(header.priorityOrderOffset));
+        out.write(reinterpret_cast<const char*>(order.data()), static_cast<std::streamsize>(order.size() * sizeof(uint32_t)));
+    }
+
+    TaskManager reopened;
+    reopened.loadTasks(file);
+    CHECK_EQ(reopened.getTaskCount(), saved.getTaskCount());
+    CHECK(priorityWalk(reopened) == priorityWalk(saved));
+    CHECK(deadlineWalk(reopened) == deadlineWalk(saved));
+}
+
+// The keyword index is built on the first lookup, after any mutations made before it
+TEST_CASE(saved_orders, keyword_lookup_after_load_and_edits) {
+    ScratchDir dir("saved_orders_keywords");
+    const std::string file = dir.file("tasks.snap");
+    std::vector<TaskId> ids;
+    {
+        TaskManager saved;
+        ids = fillAndSave(file, saved);
+    }
+
+    TaskManager reopened;
+    reopened.loadTasks(file);
+    reopened.removeTask(ids[0]);
+    reopened.editTask(ids[1], Task("renamed zebra", "", start, Priority::High, "work"));
+    reopened.addTask(Task("another zebra", "", start, Priority::Low, "home"));
+
+    size_t expected = 0;
+    for (size_t i = 0; i < reopened.getTaskCount(); ++i) {
+        if (reopened.getTaskByIndex(i).getTitle().find("task 12") != std::string::npos) ++expected;
+    }
+    CHECK(expected > 0);
+    CHECK_EQ(reopened.findTasksByKeyword("task 12").size(), expected);
+    CHECK_EQ(reopened.findTasksByKeyword("zebra").size(), size_t(2));
+
+    // Once built, the index follows mutations again
+    reopened.removeTask(ids[2]);
+    reopened.addTask(Task("third zebra", "", start, Priority::Low, "home"));
+    CHECK_EQ(reopened.findTasksByKeyword("zebra").size(), size_t(3));
+}
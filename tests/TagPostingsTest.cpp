@@ -0,0 +1,59 @@
+#include "TestHarness.h"
+#include "TaskManager.h"
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+// The tag postings stay in step with the task list through swap-removes and edits
+
+namespace {
+    Task makeTask(int number, const std::string& tag) {
+        return Task("task " + std::to_string(number), "", std::chrono::system_clock::now() + std::chrono::hours(number % 100),
+            Priority::Low, tag);
+    }
+
+    // Every tag's filter against a scan of the tag column, in list order
+    void checkAgainstScan(const TaskManager& manager, const std::vector<std::string>& tags) {
+        for (const auto& tag : tags) {
+            std::vector<size_t> expected;
+            for (size_t i = 0; i < manager.getTaskCount(); ++i) {
+                if (manager.getTaskByIndex(i).getTag() == tag) expected.push_back(i);
+            }
+            std::vector<size_t> actual;
+            for (const TaskEntry& entry : manager.filterTasksByTag(tag)) actual.push_back(entry.index);
+            CHECK(actual == expected);
+            CHECK_EQ(manager.countTasksByTag(tag), expected.size());
+        }
+    }
+}
+
+// Spans two 65536-position chunks, with tags dense enough to use bitmap chunks
+TEST_CASE(tag_postings, filter_matches_scan_after_removes_and_edits) {
+    const std::vector<std::string> tags = { "work", "home", "rare" };
+    std::mt19937_64 random(21);
+    TaskManager manager;
+    std::vector<TaskId> ids;
+    for (int i = 0; i < 80000; ++i) {
+        ids.push_back(manager.addTask(makeTask(i, i % 1000 == 0 ? "rare" : tags[i % 2])));
+    }
+    checkAgainstScan(manager, tags);
+
+    for (int i = 0; i < 8000; ++i) {
+        size_t pick = random() % ids.size();
+        if (i % 4 == 0) {
+            CHECK(manager.editTask(ids[pick], makeTask(i, tags[random() % tags.size()])));
+            continue;
+        }
+        CHECK(manager.removeTask(ids[pick]));
+        ids[pick] = ids.back();
+        ids.pop_back();
+    }
+    checkAgainstScan(manager, tags);
+
+    while (!ids.empty()) {
+        CHECK(manager.removeTask(ids.back()));
+        ids.pop_back();
+    }
+    checkAgainstScan(manager, tags);
+}
@@ -0,0 +1,134 @@
+#include "TestHarness.h"
+#include "TaskManager.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <string>
+
+// Ids of deleted tasks must stay unused across saves and restarts, in both file formats
+
+namespace {
+    namespace fs = std::filesystem;
+
+    // A fresh directory per test, removed again when the test ends
+    struct ScratchDir {
+        fs::path path;
+        explicit ScratchDir(const std::string& name)
+            : path(fs::temp_directory_path() / ("task_manager_tests_" + name)) {
+            fs::remove_all(path);
+            fs::create_directories(path);
+        }
+        ~ScratchDir() {
+            std::error_code ec;
+            fs::remove_all(path, ec);
+        }
+        std::string file(const std::string& name) const { return (path / name).string(); }
+    };
+
+    Task makeTask(const std::string& title) {
+        return Task(title, "", std::chrono::system_clock::now() + std::chrono::hours(24), Priority::Medium, "work");
+    }
+
+    const char* const extensions[] = { ".json", ".snap" };
+}
+
+// The review repro: the task deleted last is not in the snapshot at all
+TEST_CASE(task_ids, deleted_id_not_reissued_after_snapshot) {
+    for (const char* extension : extensions) {
+        ScratchDir dir(std::string("snapshot") + extension);
+        const std::string file = dir.file(std::string("tasks") + extension);
+
+        TaskId deleted = 0;
+        {
+            TaskManager manager;
+            manager.loadTasks(file);
+            manager.addTask(makeTask("A"));
+            deleted = manager.addTask(makeTask("B"));
+            CHECK(manager.removeTask(deleted));
+            manager.saveTasks(file);
+        }
+
+        TaskManager reopened;
+        reopened.loadTasks(file);
+        CHECK_EQ(reopened.getTaskCount(), size_t(1));
+        CHECK(!reopened.indexOf(deleted));
+        TaskId added = reopened.addTask(makeTask("C"));
+        CHECK(added != deleted);
+        CHECK(!reopened.indexOf(deleted));
+    }
+}
+
+// The delete only reached the journal; replaying it must leave the id retired as well
+TEST_CASE(task_ids, deleted_id_not_reissued_after_journal_replay) {
+    for (const char* extension : extensions) {
+        ScratchDir dir(std::string("journal") + extension);
+        const std::string file = dir.file(std::string("tasks") + extension);
+
+        TaskId deleted = 0;
+        {
+            TaskManager manager;
+            manager.loadTasks(file);
+            manager.addTask(makeTask("A"));
+            deleted = manager.addTask(makeTask("B"));
+            manager.saveTasks(file);
+            CHECK(manager.removeTask(deleted));
+            manager.commitChanges();
+        }
+
+        TaskManager reopened;
+        reopened.loadTasks(file);
+        CHECK_EQ(reopened.getTaskCount(), size_t(1));
+        CHECK(reopened.addTask(makeTask("C")) != deleted);
+    }
+}
+
+// Enough deletes that freed slots get reused after the restart: every reused slot must
+// come back under a newer generation than the id it held before
+TEST_CASE(task_ids, reused_slots_keep_their_generations) {
+    for (const char* extension : extensions) {
+        ScratchDir dir(std::string("reuse") + extension);
+        const std::string file = dir.file(std::string("tasks") + extension);
+
+        std::set<TaskId> issued;
+        {
+            TaskManager manager;
+            manager.loadTasks(file);
+            for (int i = 0; i < 3000; ++i) issued.insert(manager.addTask(makeTask("task " + std::to_string(i))));
+            for (TaskId id : issued) {
+                if (id % 3 != 0) manager.removeTask(id);
+            }
+            manager.saveTasks(file);
+        }
+
+        for (int restart = 0; restart < 2; ++restart) {
+            TaskManager reopened;
+            reopened.loadTasks(file);
+            for (int i = 0; i < 2500; ++i) {
+                TaskId added = reopened.addTask(makeTask("new " + std::to_string(i)));
+                CHECK(issued.insert(added).second);
+                if (i % 2 == 0) reopened.removeTask(added);
+            }
+            reopened.saveTasks(file);
+        }
+    }
+}
+
+// Files saved as a bare array of tasks (before the id state was saved) still load
+TEST_CASE(task_ids, bare_task_array_still_loads) {
+    ScratchDir dir("bare_array");
+    const std::string file = dir.file("tasks.json");
+    {
+        std::ofstream out(file);
+        out << R"([
+            { "title": "A", "description": "", "deadline": 1767261600, "priority": 1, "tag": "work", "completed": false, "id": 1 },
+            { "title": "B", "description": "", "deadline": 1767261600, "priority": 2, "tag": "home", "completed": true, "id": 3 }
+        ])";
+    }
+
+    TaskManager manager;
+    manager.loadTasks(file);
+    CHECK_EQ(manager.getTaskCount(), size_t(2));
+    CHECK(manager.indexOf(1) && manager.indexOf(3));
+    CHECK(manager.addTask(makeTask("C")) != TaskId(2)); // the gap most likely held a deleted task
+}
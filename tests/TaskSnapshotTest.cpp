@@ -0,0 +1,126 @@
+#include "TestHarness.h"
+#include "TaskManager.h"
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+// Published snapshots share column pages with the live list but never see its later edits
+
+namespace {
+    using Clock = std::chrono::system_clock;
+
+    const Clock::time_point start = Clock::now();
+
+    Task makeTask(int number) {
+        return Task("task " + std::to_string(number), "details", start + std::chrono::hours(number % 200 - 100),
+            static_cast<Priority>(number % 3), number % 2 ? "work" : "home", number % 5 == 0);
+    }
+
+    // Everything a reader might look at, row by row
+    struct Row {
+        std::string title;
+        int64_t deadline;
+        int priority;
+        bool completed;
+        TaskId id;
+        bool operator==(const Row& other) const {
+            return title == other.title && deadline == other.deadline && priority == other.priority &&
+                completed == other.completed && id == other.id;
+        }
+    };
+
+    std::vector<Row> rowsOf(const TaskTable& tasks) {
+        std::vector<Row> rows;
+        for (size_t i = 0; i < tasks.size(); ++i) {
+            rows.push_back(Row{ std::string(tasks.title(i)), tasks.deadlineColumn()[i],
+                static_cast<int>(tasks.priority(i)), tasks.completed(i), tasks.id(i) });
+        }
+        return rows;
+    }
+}
+
+TEST_CASE(task_snapshots, later_edits_do_not_reach_a_snapshot) {
+    TaskManager manager;
+    std::vector<TaskId> ids;
+    for (int i = 0; i < 5000; ++i) ids.push_back(manager.addTask(makeTask(i)));
+
+    auto snapshot = manager.snapshot();
+    const std::vector<Row> before = rowsOf(snapshot->tasks);
+
+    std::mt19937_64 random(10);
+    for (int i = 0; i < 3000; ++i) {
+        size_t pick = random() % ids.size();
+        switch (i % 4) {
+        case 0: manager.editTask(ids[pick], makeTask(i + 7)); break;
+        case 1: manager.setCompleted(ids[pick], true); break;
+        case 2:
+            manager.removeTask(ids[pick]);
+            ids[pick] = ids.back();
+            ids.pop_back();
+            break;
+        default: ids.push_back(manager.addTask(makeTask(i))); break;
+        }
+    }
+
+    CHECK(rowsOf(snapshot->tasks) == before);
+    CHECK(rowsOf(manager.snapshot()->tasks) == rowsOf(manager.getAllTasks()));
+}
+
+// One edit after a publish copies the edited row's page of each column, nothing else
+TEST_CASE(task_snapshots, one_edit_copies_one_page) {
+    TaskManager manager;
+    std::vector<TaskId> ids;
+    const size_t pages = 8;
+    for (size_t i = 0; i < pages * TaskTable::pageRows; ++i) ids.push_back(manager.addTask(makeTask(static_cast<int>(i))));
+
+    auto snapshot = manager.snapshot();
+    const size_t edited = 3 * TaskTable::pageRows + 17;
+    manager.editTask(ids[edited], makeTask(99));
+
+    const TaskTable& live = manager.getAllTasks();
+    const TaskTable& published = snapshot->tasks;
+    for (size_t page = 0; page < pages; ++page) {
+        const bool copied = page == edited / TaskTable::pageRows;
+        CHECK_EQ(live.deadlineColumn().page(page) != published.deadlineColumn().page(page), copied);
+        CHECK_EQ(live.priorityColumn().page(page) != published.priorityColumn().page(page), copied);
+        CHECK_EQ(live.tagColumn().page(page) != published.tagColumn().page(page), copied);
+        CHECK_EQ(live.idColumn().page(page) == published.idColumn().page(page), !copied);
+    }
+    CHECK(published.title(edited) == "task " + std::to_string(edited));
+    CHECK(live.title(edited) == "task 99");
+}
+
+// The range queries scan the snapshot's own columns; compare them with a plain loop
+TEST_CASE(task_snapshots, due_ranges_match_a_scan) {
+    TaskManager manager;
+    for (int i = 0; i < 3000; ++i) manager.addTask(makeTask(i));
+    auto snapshot = manager.snapshot();
+    const TaskTable& tasks = snapshot->tasks;
+
+    const Clock::time_point from = start - std::chrono::hours(5);
+    const Clock::time_point to = start + std::chrono::hours(48);
+    size_t between = 0, incompleteBetween = 0, before = 0, incompleteBefore = 0;
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        Clock::time_point deadline = tasks.deadline(i);
+        if (deadline >= from && deadline <= to) {
+            ++between;
+            if (!tasks.completed(i)) ++incompleteBetween;
+        }
+        if (deadline < from) {
+            ++before;
+            if (!tasks.completed(i)) ++incompleteBefore;
+        }
+    }
+
+    TaskView due = snapshot->dueBetween(from, to);
+    CHECK_EQ(due.size(), between);
+    for (size_t i = 1; i < due.size(); ++i) {
+        CHECK(due[i - 1].task.getDeadline() < due[i].task.getDeadline() ||
+            (due[i - 1].task.getDeadline() == due[i].task.getDeadline() && due[i - 1].index < due[i].index));
+    }
+    CHECK_EQ(snapshot->dueBefore(from).size(), before);
+    CHECK_EQ(snapshot->countIncompleteDueBetween(from, to), incompleteBetween);
+    CHECK_EQ(snapshot->countIncompleteDueBefore(from), incompleteBefore);
+    CHECK_EQ(snapshot->dueBetween(to, from).size(), size_t(0));
+}
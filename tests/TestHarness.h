@@ -0,0 +1,39 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+// A minimal test registry, so the tests need nothing beyond the standard library.
+// TEST_CASE(group, name) defines a test; the runner takes a group name to run only that group.
+struct TestCase {
+    std::string group;
+    std::string name;
+    void (*run)();
+};
+
+std::vector<TestCase>& testRegistry();
+
+struct TestRegistrar {
+    TestRegistrar(const char* group, const char* name, void (*run)());
+};
+
+// Records a failed check; the test goes on, so one run reports every mismatch
+void reportFailure(const char* file, int line, const std::string& message);
+
+#define TEST_CASE(group, name) \
+    static void group##_##name(); \
+    static TestRegistrar group##_##name##_registrar(#group, #name, group##_##name); \
+    static void group##_##name()
+
+#define CHECK(condition) \
+    do { if (!(condition)) reportFailure(__FILE__, __LINE__, "CHECK(" #condition ")"); } while (false)
+
+#define CHECK_EQ(actual, expected) \
+    do { \
+        auto&& checkActual = (actual); \
+        auto&& checkExpected = (expected); \
+        if (!(checkActual == checkExpected)) { \
+            reportFailure(__FILE__, __LINE__, "CHECK_EQ(" #actual ", " #expected "): got " + \
+                std::to_string(checkActual) + ", expected " + std::to_string(checkExpected)); \
+        } \
+    } while (false)
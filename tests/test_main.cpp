@@ -0,0 +1,47 @@
+#include "TestHarness.h"
+#include <exception>
+#include <iostream>
+
+// Runs every registered test, or only those of the group named on the command line
+
+static size_t failures = 0;
+
+std::vector<TestCase>& testRegistry() {
+    static std::vector<TestCase> registry;
+    return registry;
+}
+
+TestRegistrar::TestRegistrar(const char* group, const char* name, void (*run)()) {
+    testRegistry().push_back(TestCase{ group, name, run });
+}
+
+void reportFailure(const char* file, int line, const std::string& message) {
+    std::cerr << file << ':' << line << ": " << message << '\n';
+    ++failures;
+}
+
+int main(int argc, char** argv) {
+    const std::string group = argc > 1 ? argv[1] : "";
+    size_t ran = 0, failed = 0;
+    for (const TestCase& test : testRegistry()) {
+        if (!group.empty() && test.group != group) continue;
+        ++ran;
+        size_t before = failures;
+        try {
+            test.run();
+        }
+        catch (const std::exception& e) {
+            reportFailure(test.name.c_str(), 0, std::string("threw: ") + e.what());
+        }
+        bool passed = failures == before;
+        if (!passed) ++failed;
+        std::cout << (passed ? "[ OK ] " : "[FAIL] ") << test.group << '.' << test.name << '\n';
+    }
+
+    if (ran == 0) {
+        std::cerr << "No tests in group '" << group << "'\n";
+        return 1;
+    }
+    std::cout << ran - failed << '/' << ran << " tests passed\n";
+    return failed == 0 ? 0 : 1;
+}